@@ -249,6 +249,18 @@ namespace jsoncons {
         using parse_error_handler_type = default_json_parsing;
     };
 
+    // Like sorted_policy, with a hash index for finding members in large objects
+    struct indexed_sorted_policy 
+    {
+        template <class KeyT,class Json>
+        using object = indexed_sorted_json_object<KeyT,Json,std::vector>;
+
+        template <class Json>
+        using array = json_array<Json,std::vector>;
+
+        using parse_error_handler_type = default_json_parsing;
+    };
+
     struct order_preserving_policy
     {
         template <class KeyT,class Json>
@@ -932,6 +944,38 @@ namespace jsoncons {
             }
         };
 
+        // Refers to characters that the value does not own, e.g. the input of a parse,
+        // which must outlive the value and all copies of it
+        class string_view_storage final
+        {
+        public:
+            uint8_t storage_kind_:4;
+            uint8_t length_:4;
+            semantic_tag tag_;
+        private:
+            uint32_t size_;
+            const char_type* data_;
+        public:
+            static constexpr std::size_t max_length = (std::numeric_limits<uint32_t>::max)();
+
+            string_view_storage(semantic_tag tag, const char_type* data, std::size_t length)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::string_view_value)), length_(0), tag_(tag),
+                  size_(static_cast<uint32_t>(length)), data_(data)
+            {
+                JSONCONS_ASSERT(length <= max_length);
+            }
+
+            const char_type* data() const
+            {
+                return data_;
+            }
+
+            std::size_t length() const
+            {
+                return size_;
+            }
+        };
+
         template <class ParentType>
         class proxy 
         {
@@ -1566,6 +1610,11 @@ namespace jsoncons {
                 return evaluate().to_string();
             }
 
+            std::basic_string<char_type> to_string(const basic_json_encode_options<char_type>& options) const 
+            {
+                return evaluate().to_string(options);
+            }
+
             template <class IntegerType>
             bool is_integer() const noexcept
             {
@@ -1920,6 +1969,7 @@ namespace jsoncons {
             object_storage object_stor_;
             empty_object_storage empty_object_stor_;
             json_const_pointer_storage json_const_pointer_stor_;
+            string_view_storage string_view_stor_;
         };
 
         void Destroy_()
@@ -2100,6 +2150,16 @@ namespace jsoncons {
             return json_const_pointer_stor_;
         }
 
+        string_view_storage& cast(identity<string_view_storage>) 
+        {
+            return string_view_stor_;
+        }
+
+        const string_view_storage& cast(identity<string_view_storage>) const
+        {
+            return string_view_stor_;
+        }
+
         template <class TypeA, class TypeB>
         void swap_a_b(basic_json& other)
         {
@@ -2128,6 +2188,7 @@ namespace jsoncons {
                 case json_storage_kind::array_value        : swap_a_b<TypeA, array_storage>(other); break;
                 case json_storage_kind::object_value       : swap_a_b<TypeA, object_storage>(other); break;
                 case json_storage_kind::json_const_pointer : swap_a_b<TypeA, json_const_pointer_storage>(other); break;
+                case json_storage_kind::string_view_value  : swap_a_b<TypeA, string_view_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -2177,6 +2238,9 @@ namespace jsoncons {
                 case json_storage_kind::json_const_pointer:
                     construct<json_const_pointer_storage>(val.cast<json_const_pointer_storage>());
                     break;
+                case json_storage_kind::string_view_value:
+                    construct<string_view_storage>(val.cast<string_view_storage>());
+                    break;
                 default:
                     break;
             }
@@ -2195,6 +2259,7 @@ namespace jsoncons {
                 case json_storage_kind::double_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     Init_(val);
                     break;
                 case json_storage_kind::long_string_value:
@@ -2227,6 +2292,7 @@ namespace jsoncons {
                 case json_storage_kind::bool_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     Init_(val);
                     break;
                 case json_storage_kind::long_string_value:
@@ -2262,6 +2328,7 @@ namespace jsoncons {
                 case json_storage_kind::bool_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     Init_(std::forward<basic_json>(val));
                     break;
                 case json_storage_kind::long_string_value:
@@ -2390,6 +2457,7 @@ namespace jsoncons {
                     return json_type::double_value;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return json_type::string_value;
                 case json_storage_kind::byte_string_value:
                     return json_type::byte_string_value;
@@ -2446,6 +2514,8 @@ namespace jsoncons {
                     return string_view_type(cast<short_string_storage>().data(),cast<short_string_storage>().length());
                 case json_storage_kind::long_string_value:
                     return string_view_type(cast<long_string_storage>().data(),cast<long_string_storage>().length());
+                case json_storage_kind::string_view_value:
+                    return string_view_type(cast<string_view_storage>().data(),cast<string_view_storage>().length());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->as_string_view();
                 default:
@@ -2464,6 +2534,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     byte_string_type v = convert.from(as_string_view(),tag(),ec);
                     if (ec)
@@ -2616,11 +2687,13 @@ namespace jsoncons {
                     break;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     switch (rhs.storage_kind())
                     {
                         case json_storage_kind::short_string_value:
                             return as_string_view().compare(rhs.as_string_view());
                         case json_storage_kind::long_string_value:
+                        case json_storage_kind::string_view_value:
                             return as_string_view().compare(rhs.as_string_view());
                         case json_storage_kind::json_const_pointer:
                             return compare(*(rhs.cast<json_const_pointer_storage>().value()));
@@ -2703,6 +2776,7 @@ namespace jsoncons {
                 case json_storage_kind::array_value: swap_a<array_storage>(other); break;
                 case json_storage_kind::object_value: swap_a<object_storage>(other); break;
                 case json_storage_kind::json_const_pointer: swap_a<json_const_pointer_storage>(other); break;
+                case json_storage_kind::string_view_value: swap_a<string_view_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -2746,6 +2820,39 @@ namespace jsoncons {
             return parse(s, basic_json_decode_options<CharT>(), err_handler);
         }
 
+        // from string, with unescaped string values referring into s, which must outlive the result
+
+        static basic_json parse(string_view_arg_t, const string_view_type& s, 
+                                const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>(), 
+                                std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+        {
+            json_decoder<basic_json> decoder;
+            basic_json_parser<char_type> parser(options,err_handler);
+
+            auto r = unicode_traits::detect_encoding_from_bom(s.data(), s.size());
+            if (!(r.encoding == unicode_traits::encoding_kind::utf8 || r.encoding == unicode_traits::encoding_kind::undetected))
+            {
+                JSONCONS_THROW(ser_error(json_errc::illegal_unicode_character,parser.line(),parser.column()));
+            }
+            std::size_t offset = (r.ptr - s.data());
+            decoder.string_view_source(s);
+            parser.update(s.data()+offset,s.size()-offset);
+            parser.parse_some(decoder);
+            parser.finish_parse(decoder);
+            parser.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error, "Failed to parse json string"));
+            }
+            return decoder.get_result();
+        }
+
+        static basic_json parse(string_view_arg_t, const string_view_type& s, 
+                                std::function<bool(json_errc,const ser_context&)> err_handler)
+        {
+            return parse(string_view_arg, s, basic_json_decode_options<CharT>(), err_handler);
+        }
+
         static basic_json parse(const char_type* s, 
                                 const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(), 
                                 std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
@@ -2969,6 +3076,18 @@ namespace jsoncons {
             }
         }
 
+        basic_json(string_view_arg_t, const string_view_type& sv, semantic_tag tag = semantic_tag::none)
+        {
+            if (sv.length() <= string_view_storage::max_length)
+            {
+                construct<string_view_storage>(tag, sv.data(), sv.length());
+            }
+            else
+            {
+                construct<long_string_storage>(tag, sv.data(), sv.length(), char_allocator_type());
+            }
+        }
+
         basic_json(const array& val, semantic_tag tag = semantic_tag::none)
         {
             construct<array_storage>(val, tag);
@@ -3564,6 +3683,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return true;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_string();
@@ -3601,6 +3721,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return jsoncons::detail::is_base10(as_string_view().data(), as_string_view().length());
                 case json_storage_kind::int64_value:
                 case json_storage_kind::uint64_value:
@@ -3719,6 +3840,7 @@ namespace jsoncons {
                     return true;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return tag() == semantic_tag::bigint ||
                            tag() == semantic_tag::bigdec ||
                            tag() == semantic_tag::bigfloat;
@@ -3740,6 +3862,8 @@ namespace jsoncons {
                     return cast<short_string_storage>().length() == 0;
                 case json_storage_kind::long_string_value:
                     return cast<long_string_storage>().length() == 0;
+                case json_storage_kind::string_view_value:
+                    return cast<string_view_storage>().length() == 0;
                 case json_storage_kind::array_value:
                     return array_value().empty();
                 case json_storage_kind::empty_object_value:
@@ -3855,6 +3979,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     switch (tag())
                     {
@@ -3915,6 +4040,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -3966,6 +4092,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -4007,6 +4134,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -4034,6 +4162,13 @@ namespace jsoncons {
                     // to_double() throws std::invalid_argument if conversion fails
                     return to_double(as_cstring(), as_string_view().length());
                 }
+                case json_storage_kind::string_view_value:
+                {
+                    // to_double() may need a null terminated string
+                    std::basic_string<char_type> s(as_string_view().data(), as_string_view().length());
+                    jsoncons::detail::chars_to to_double;
+                    return to_double(s.c_str(), s.length());
+                }
                 case json_storage_kind::half_value:
                     return binary::decode_half(cast<half_storage>().value());
                 case json_storage_kind::double_value:
@@ -4066,6 +4201,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     return string_type(as_string_view().data(),as_string_view().length(),alloc);
                 }
@@ -4789,6 +4925,15 @@ namespace jsoncons {
             return s;
         }
 
+        std::basic_string<char_type> to_string(const basic_json_encode_options<char_type>& options) const
+        {
+            using string_type = std::basic_string<char_type>;
+            string_type s;
+            basic_compact_json_encoder<char_type, jsoncons::string_sink<string_type>> encoder(s, options);
+            dump(encoder);
+            return s;
+        }
+
     #if !defined(JSONCONS_NO_DEPRECATED)
         JSONCONS_DEPRECATED_MSG("Instead, use basic_json(byte_string_arg_t, const Source&, semantic_tag=semantic_tag::none,const Allocator& = Allocator())")
         basic_json(const byte_string_view& bytes, 
@@ -5438,6 +5583,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     visitor.string_value(as_string_view(), tag(), context, ec);
                     break;
                 case json_storage_kind::byte_string_value:
@@ -5557,6 +5703,8 @@ namespace jsoncons {
                 }
                 case json_storage_kind::json_const_pointer:
                     return deep_copy(*(other.cast<json_const_pointer_storage>().value()));
+                case json_storage_kind::string_view_value:
+                    return basic_json(other.as_string_view().data(), other.as_string_view().length(), other.tag());
                 default:
                     return other;
             }
@@ -5797,6 +5945,8 @@ namespace jsoncons {
     using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
     using ojson = basic_json<char, order_preserving_policy, std::allocator<char>>;
     using wojson = basic_json<wchar_t, order_preserving_policy, std::allocator<char>>;
+    using arena_json = basic_json<char,sorted_policy,arena_allocator<char>>;
+    using arena_ojson = basic_json<char,order_preserving_policy,arena_allocator<char>>;
 
     #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, order_preserving_policy, std::allocator<wchar_t>> owjson;
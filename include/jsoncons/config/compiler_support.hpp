@@ -322,6 +322,19 @@
 #endif
 #endif
 
+// SIMD instruction sets, define JSONCONS_NO_SIMD to use the portable scalar code paths only
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#  endif
+#  if (defined(__ARM_NEON) || defined(_M_ARM64)) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define JSONCONS_HAS_NEON 1
+#  endif
+#endif // !defined(JSONCONS_NO_SIMD)
+
 // Follows boost config/detail/suffix.hpp
 #if defined(JSONCONS_HAS_INT128) && defined(__cplusplus)
 namespace jsoncons{
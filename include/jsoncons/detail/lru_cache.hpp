@@ -0,0 +1,116 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_LRU_CACHE_HPP
+#define JSONCONS_DETAIL_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <unordered_map>
+#include <utility> // std::move
+
+namespace jsoncons {
+
+    struct cache_stats
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t evictions;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+namespace detail {
+
+    // A thread safe map of at most capacity values, evicting the least recently used.
+    // Values are shared, so an evicted value stays alive while a caller still holds it.
+    template <class Key,class Value>
+    class lru_cache
+    {
+    public:
+        using key_type = Key;
+        using value_pointer = std::shared_ptr<const Value>;
+    private:
+        using entry_list = std::list<std::pair<Key,value_pointer>>;
+
+        std::size_t capacity_;
+        mutable std::mutex mutex_;
+        entry_list entries_; // most recently used first
+        std::unordered_map<Key,typename entry_list::iterator> index_;
+        std::size_t hits_;
+        std::size_t misses_;
+        std::size_t evictions_;
+    public:
+        explicit lru_cache(std::size_t capacity)
+            : capacity_(capacity == 0 ? 1 : capacity), hits_(0), misses_(0), evictions_(0)
+        {
+        }
+
+        lru_cache(const lru_cache&) = delete;
+        lru_cache& operator=(const lru_cache&) = delete;
+
+        // Returns the cached value, or the value made by create(), which is called
+        // without holding the lock. If create() throws, nothing is cached.
+        template <class Create>
+        value_pointer get_or_create(const Key& key, Create create)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = index_.find(key);
+                if (it != index_.end())
+                {
+                    ++hits_;
+                    entries_.splice(entries_.begin(), entries_, it->second);
+                    return it->second->second;
+                }
+                ++misses_;
+            }
+
+            value_pointer value = create();
+            if (!value)
+            {
+                return value;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(key);
+            if (it != index_.end())
+            {
+                // made concurrently by another caller
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return it->second->second;
+            }
+            entries_.emplace_front(key, value);
+            index_.emplace(key, entries_.begin());
+            while (entries_.size() > capacity_)
+            {
+                index_.erase(entries_.back().first);
+                entries_.pop_back();
+                ++evictions_;
+            }
+            return value;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            index_.clear();
+            entries_.clear();
+        }
+
+        cache_stats stats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return cache_stats{hits_, misses_, evictions_, entries_.size(), capacity_};
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
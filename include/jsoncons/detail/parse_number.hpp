@@ -18,6 +18,7 @@
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -926,6 +927,10 @@ public:
     operator()(const CharT* s, std::size_t len) const
     {
         double val = 0;
+        if (decimal_to_double(s, len, get_decimal_point(), val))
+        {
+            return val;
+        }
         const auto res = std::from_chars(s, s+len, val);
         if (res.ec != std::errc())
         {
@@ -938,13 +943,18 @@ public:
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
     operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, len, static_cast<CharT>(get_decimal_point()), val))
+        {
+            return val;
+        }
+
         std::string input(len,'0');
         for (size_t i = 0; i < len; ++i)
         {
             input[i] = static_cast<char>(s[i]);
         }
 
-        double val = 0;
         const auto res = std::from_chars(input.data(), input.data() + len, val);
         if (res.ec != std::errc())
         {
@@ -987,10 +997,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, get_decimal_point(), val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _strtod_l(s, &end, locale_);
+        val = _strtod_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1000,10 +1015,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _wcstod_l(s, &end, locale_);
+        val = _wcstod_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1045,10 +1065,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, get_decimal_point(), val))
+        {
+            return val;
+        }
         char *end = nullptr;
-        double val = strtold_l(s, &end, locale_);
+        val = strtold_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1058,10 +1083,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstold_l(s, &end, locale_);
+        val = wcstold_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1102,10 +1132,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, get_decimal_point(), val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = strtod(s, &end);
+        val = strtod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1115,10 +1150,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstod(s, &end);
+        val = wcstod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
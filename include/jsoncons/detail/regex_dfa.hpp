@@ -0,0 +1,851 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_REGEX_DFA_HPP
+#define JSONCONS_DETAIL_REGEX_DFA_HPP
+
+#include <algorithm> // std::sort
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <utility> // std::move
+
+namespace jsoncons {
+namespace detail {
+
+    // A deterministic automaton for the common subset of ECMAScript regular expressions:
+    // literals, '.', bracket expressions, the class escapes \d \w \s and their complements,
+    // groups, alternation, greedy and lazy quantifiers, and the anchors '^' and '$'.
+    // Matching is on bytes, with case folding for ASCII letters, which is what std::regex
+    // does for char in the "C" locale. compile returns false for anything outside the
+    // subset (back references, assertions other than anchors, word boundaries,
+    // characters beyond ASCII in escapes and ranges) or for patterns that would need
+    // too many states, so that the caller can use another engine.
+    class regex_dfa
+    {
+        using byte_set = std::bitset<256>;
+
+        static constexpr std::size_t max_nfa_size = 4096;
+        static constexpr std::size_t max_dfa_size = 1024;
+
+        enum class ast_kind : uint8_t {chars, concat, alternate, repeat, bol, eol};
+
+        struct ast_node
+        {
+            ast_kind kind;
+            std::size_t set;
+            std::vector<std::size_t> children;
+            std::size_t min;
+            std::size_t max; // no_limit if unbounded
+        };
+
+        enum class nfa_kind : uint8_t {chars, split, bol, eol, match};
+
+        struct nfa_node
+        {
+            nfa_kind kind;
+            std::size_t set;
+            std::size_t out1;
+            std::size_t out2;
+        };
+
+        static constexpr std::size_t no_limit = static_cast<std::size_t>(-1);
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        // compiling
+        const char* p_;
+        const char* end_;
+        bool icase_;
+        std::vector<byte_set> sets_;
+        std::vector<ast_node> ast_;
+        std::vector<nfa_node> nfa_;
+
+        // the automaton
+        uint8_t classes_[256];
+        std::size_t class_count_;
+        std::vector<int32_t> transitions_; // state*class_count_ + class, -1 for no match possible
+        std::vector<uint8_t> accepts_;
+        std::vector<uint8_t> accepts_at_end_;
+        bool accepts_empty_input_;
+    public:
+        regex_dfa() noexcept
+            : p_(nullptr), end_(nullptr), icase_(false), classes_(), class_count_(0), accepts_empty_input_(false)
+        {
+        }
+
+        bool compile(const char* pattern, std::size_t length, bool icase)
+        {
+            p_ = pattern;
+            end_ = pattern + length;
+            icase_ = icase;
+
+            std::size_t root;
+            if (!parse_alternation(root) || p_ != end_)
+            {
+                return false;
+            }
+            std::size_t match = add_nfa(nfa_kind::match, 0, npos, npos);
+            std::size_t start;
+            if (!emit(root, match, start))
+            {
+                return false;
+            }
+            bool ok = build_dfa(start);
+            ast_.clear();
+            ast_.shrink_to_fit();
+            nfa_.clear();
+            nfa_.shrink_to_fit();
+            sets_.clear();
+            sets_.shrink_to_fit();
+            return ok;
+        }
+
+        // Whether the pattern matches some part of [data, data+length)
+        bool search(const char* data, std::size_t length) const noexcept
+        {
+            std::size_t state = 0;
+            if (accepts_[state])
+            {
+                return true;
+            }
+            if (length == 0)
+            {
+                return accepts_empty_input_;
+            }
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+            const unsigned char* end = p + length;
+            for (; p != end; ++p)
+            {
+                int32_t next = transitions_[state*class_count_ + classes_[*p]];
+                if (next < 0)
+                {
+                    return false;
+                }
+                state = static_cast<std::size_t>(next);
+                if (accepts_[state])
+                {
+                    return true;
+                }
+            }
+            return accepts_at_end_[state] != 0;
+        }
+
+    private:
+        // parsing
+
+        std::size_t add_ast(ast_kind kind, std::size_t set = 0)
+        {
+            ast_.push_back(ast_node{kind, set, std::vector<std::size_t>(), 1, 1});
+            return ast_.size() - 1;
+        }
+
+        std::size_t add_set(const byte_set& set)
+        {
+            sets_.push_back(set);
+            return sets_.size() - 1;
+        }
+
+        bool parse_alternation(std::size_t& result)
+        {
+            std::size_t first;
+            if (!parse_concat(first))
+            {
+                return false;
+            }
+            if (p_ == end_ || *p_ != '|')
+            {
+                result = first;
+                return true;
+            }
+            std::size_t alt = add_ast(ast_kind::alternate);
+            ast_[alt].children.push_back(first);
+            while (p_ != end_ && *p_ == '|')
+            {
+                ++p_;
+                std::size_t next;
+                if (!parse_concat(next))
+                {
+                    return false;
+                }
+                ast_[alt].children.push_back(next);
+            }
+            result = alt;
+            return true;
+        }
+
+        bool parse_concat(std::size_t& result)
+        {
+            std::size_t concat = add_ast(ast_kind::concat);
+            while (p_ != end_ && *p_ != '|' && *p_ != ')')
+            {
+                std::size_t atom;
+                if (!parse_repeat(atom))
+                {
+                    return false;
+                }
+                ast_[concat].children.push_back(atom);
+            }
+            result = concat;
+            return true;
+        }
+
+        bool parse_repeat(std::size_t& result)
+        {
+            std::size_t atom;
+            if (!parse_atom(atom))
+            {
+                return false;
+            }
+            if (p_ == end_)
+            {
+                result = atom;
+                return true;
+            }
+            std::size_t min = 1;
+            std::size_t max = 1;
+            switch (*p_)
+            {
+                case '*':
+                    min = 0; max = no_limit; ++p_;
+                    break;
+                case '+':
+                    min = 1; max = no_limit; ++p_;
+                    break;
+                case '?':
+                    min = 0; max = 1; ++p_;
+                    break;
+                case '{':
+                    ++p_;
+                    if (!parse_count(min))
+                    {
+                        return false;
+                    }
+                    max = min;
+                    if (p_ != end_ && *p_ == ',')
+                    {
+                        ++p_;
+                        max = no_limit;
+                        if (p_ != end_ && *p_ != '}' && !parse_count(max))
+                        {
+                            return false;
+                        }
+                    }
+                    if (p_ == end_ || *p_ != '}' || max < min)
+                    {
+                        return false;
+                    }
+                    ++p_;
+                    break;
+                default:
+                    result = atom;
+                    return true;
+            }
+            // anchors cannot be quantified
+            if (ast_[atom].kind == ast_kind::bol || ast_[atom].kind == ast_kind::eol)
+            {
+                return false;
+            }
+            // a lazy quantifier matches the same strings, only the match found differs
+            if (p_ != end_ && *p_ == '?')
+            {
+                ++p_;
+            }
+            if (p_ != end_ && (*p_ == '*' || *p_ == '+' || *p_ == '?' || *p_ == '{'))
+            {
+                return false;
+            }
+            std::size_t rep = add_ast(ast_kind::repeat);
+            ast_[rep].children.push_back(atom);
+            ast_[rep].min = min;
+            ast_[rep].max = max;
+            result = rep;
+            return true;
+        }
+
+        bool parse_count(std::size_t& n)
+        {
+            if (p_ == end_ || *p_ < '0' || *p_ > '9')
+            {
+                return false;
+            }
+            n = 0;
+            while (p_ != end_ && *p_ >= '0' && *p_ <= '9')
+            {
+                n = n*10 + static_cast<std::size_t>(*p_ - '0');
+                if (n > max_nfa_size)
+                {
+                    return false;
+                }
+                ++p_;
+            }
+            return true;
+        }
+
+        bool parse_atom(std::size_t& result)
+        {
+            char c = *p_;
+            switch (c)
+            {
+                case '(':
+                {
+                    ++p_;
+                    if (p_ != end_ && *p_ == '?')
+                    {
+                        // only non-capturing groups, no lookahead
+                        if (end_ - p_ < 2 || p_[1] != ':')
+                        {
+                            return false;
+                        }
+                        p_ += 2;
+                    }
+                    if (!parse_alternation(result))
+                    {
+                        return false;
+                    }
+                    if (p_ == end_ || *p_ != ')')
+                    {
+                        return false;
+                    }
+                    ++p_;
+                    return true;
+                }
+                case '[':
+                {
+                    ++p_;
+                    byte_set set;
+                    if (!parse_bracket(set))
+                    {
+                        return false;
+                    }
+                    result = add_ast(ast_kind::chars, add_set(set));
+                    return true;
+                }
+                case '.':
+                {
+                    ++p_;
+                    byte_set set;
+                    set.set();
+                    set.reset('\n');
+                    set.reset('\r');
+                    result = add_ast(ast_kind::chars, add_set(set));
+                    return true;
+                }
+                case '^':
+                    ++p_;
+                    result = add_ast(ast_kind::bol);
+                    return true;
+                case '$':
+                    ++p_;
+                    result = add_ast(ast_kind::eol);
+                    return true;
+                case '\\':
+                {
+                    ++p_;
+                    byte_set set;
+                    if (!parse_escape(set, false))
+                    {
+                        return false;
+                    }
+                    result = add_ast(ast_kind::chars, add_set(fold(set)));
+                    return true;
+                }
+                case '*': case '+': case '?': case '{': case '}': case ']': case ')': case '|':
+                    return false;
+                default:
+                {
+                    ++p_;
+                    byte_set set;
+                    set.set(static_cast<unsigned char>(c));
+                    result = add_ast(ast_kind::chars, add_set(fold(set)));
+                    return true;
+                }
+            }
+        }
+
+        // After '\', outside (in_bracket false) or inside a bracket expression
+        bool parse_escape(byte_set& set, bool in_bracket)
+        {
+            if (p_ == end_)
+            {
+                return false;
+            }
+            char c = *p_++;
+            switch (c)
+            {
+                case 'd': add_digits(set); return true;
+                case 'w': add_word(set); return true;
+                case 's': add_space(set); return true;
+                case 'D': { byte_set s; add_digits(s); set |= ~s; return true; }
+                case 'W': { byte_set s; add_word(s); set |= ~s; return true; }
+                case 'S': { byte_set s; add_space(s); set |= ~s; return true; }
+                default:
+                {
+                    unsigned char ch;
+                    if (!parse_escaped_char(c, ch, in_bracket))
+                    {
+                        return false;
+                    }
+                    set.set(ch);
+                    return true;
+                }
+            }
+        }
+
+        bool parse_escaped_char(char c, unsigned char& ch, bool in_bracket)
+        {
+            switch (c)
+            {
+                case 'n': ch = '\n'; return true;
+                case 'r': ch = '\r'; return true;
+                case 't': ch = '\t'; return true;
+                case 'f': ch = '\f'; return true;
+                case 'v': ch = '\v'; return true;
+                case '0':
+                    if (p_ != end_ && *p_ >= '0' && *p_ <= '9')
+                    {
+                        return false;
+                    }
+                    ch = 0;
+                    return true;
+                case 'x':
+                    return parse_hex(2, ch);
+                case 'u':
+                    return parse_hex(4, ch);
+                case '-':
+                    ch = '-';
+                    return in_bracket;
+                default:
+                    // identity escapes of syntax characters, anything else is left to
+                    // the other engine
+                    switch (c)
+                    {
+                        case '^': case '$': case '\\': case '.': case '*': case '+': case '?':
+                        case '(': case ')': case '[': case ']': case '{': case '}': case '|': case '/':
+                            ch = static_cast<unsigned char>(c);
+                            return true;
+                        default:
+                            return false;
+                    }
+            }
+        }
+
+        bool parse_hex(int digits, unsigned char& ch)
+        {
+            unsigned value = 0;
+            for (int i = 0; i < digits; ++i)
+            {
+                if (p_ == end_)
+                {
+                    return false;
+                }
+                char c = *p_++;
+                value <<= 4;
+                if (c >= '0' && c <= '9') value += static_cast<unsigned>(c - '0');
+                else if (c >= 'a' && c <= 'f') value += static_cast<unsigned>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') value += static_cast<unsigned>(c - 'A' + 10);
+                else return false;
+            }
+            if (value >= 0x80)
+            {
+                return false;
+            }
+            ch = static_cast<unsigned char>(value);
+            return true;
+        }
+
+        // After '['
+        bool parse_bracket(byte_set& result)
+        {
+            bool negate = false;
+            if (p_ != end_ && *p_ == '^')
+            {
+                negate = true;
+                ++p_;
+            }
+            // "[]" and "[^]" are read differently by different engines
+            if (p_ == end_ || *p_ == ']')
+            {
+                return false;
+            }
+            byte_set set;
+            while (p_ != end_ && *p_ != ']')
+            {
+                bool is_class = false;
+                unsigned char lo;
+                if (!parse_bracket_char(set, lo, is_class))
+                {
+                    return false;
+                }
+                if (end_ - p_ >= 2 && p_[0] == '-' && p_[1] != ']')
+                {
+                    if (is_class)
+                    {
+                        return false;
+                    }
+                    ++p_;
+                    unsigned char hi;
+                    bool hi_is_class = false;
+                    if (!parse_bracket_char(set, hi, hi_is_class) || hi_is_class || hi < lo || hi >= 0x80 || lo >= 0x80)
+                    {
+                        return false;
+                    }
+                    for (unsigned b = lo; b <= hi; ++b)
+                    {
+                        set.set(b);
+                    }
+                }
+                else if (!is_class)
+                {
+                    set.set(lo);
+                }
+            }
+            if (p_ == end_)
+            {
+                return false;
+            }
+            ++p_;
+            set = fold(set);
+            result = negate ? ~set : set;
+            return true;
+        }
+
+        bool parse_bracket_char(byte_set& set, unsigned char& ch, bool& is_class)
+        {
+            char c = *p_++;
+            if (c == '[')
+            {
+                // [:alpha:], [.a.] and [=a=] are not in the subset
+                if (p_ != end_ && (*p_ == ':' || *p_ == '.' || *p_ == '='))
+                {
+                    return false;
+                }
+                ch = '[';
+                return true;
+            }
+            if (c != '\\')
+            {
+                ch = static_cast<unsigned char>(c);
+                return true;
+            }
+            if (p_ == end_)
+            {
+                return false;
+            }
+            char e = *p_;
+            if (e == 'd' || e == 'w' || e == 's' || e == 'D' || e == 'W' || e == 'S')
+            {
+                is_class = true;
+                return parse_escape(set, true);
+            }
+            ++p_;
+            return parse_escaped_char(e, ch, true);
+        }
+
+        byte_set fold(const byte_set& set) const
+        {
+            if (!icase_)
+            {
+                return set;
+            }
+            byte_set result = set;
+            for (unsigned b = 'a'; b <= 'z'; ++b)
+            {
+                if (set.test(b) || set.test(b - 'a' + 'A'))
+                {
+                    result.set(b);
+                    result.set(b - 'a' + 'A');
+                }
+            }
+            return result;
+        }
+
+        static void add_digits(byte_set& set)
+        {
+            for (unsigned b = '0'; b <= '9'; ++b) set.set(b);
+        }
+
+        static void add_word(byte_set& set)
+        {
+            add_digits(set);
+            for (unsigned b = 'a'; b <= 'z'; ++b) set.set(b);
+            for (unsigned b = 'A'; b <= 'Z'; ++b) set.set(b);
+            set.set('_');
+        }
+
+        static void add_space(byte_set& set)
+        {
+            set.set(' '); set.set('\t'); set.set('\n'); set.set('\v'); set.set('\f'); set.set('\r');
+        }
+
+        // the nondeterministic automaton, built backwards from the node that follows
+
+        std::size_t add_nfa(nfa_kind kind, std::size_t set, std::size_t out1, std::size_t out2)
+        {
+            nfa_.push_back(nfa_node{kind, set, out1, out2});
+            return nfa_.size() - 1;
+        }
+
+        bool emit(std::size_t index, std::size_t next, std::size_t& entry)
+        {
+            if (nfa_.size() > max_nfa_size)
+            {
+                return false;
+            }
+            const ast_node& node = ast_[index];
+            switch (node.kind)
+            {
+                case ast_kind::chars:
+                    entry = add_nfa(nfa_kind::chars, node.set, next, npos);
+                    return true;
+                case ast_kind::bol:
+                    entry = add_nfa(nfa_kind::bol, 0, next, npos);
+                    return true;
+                case ast_kind::eol:
+                    entry = add_nfa(nfa_kind::eol, 0, next, npos);
+                    return true;
+                case ast_kind::concat:
+                    for (std::size_t i = node.children.size(); i-- > 0; )
+                    {
+                        if (!emit(node.children[i], next, next))
+                        {
+                            return false;
+                        }
+                    }
+                    entry = next;
+                    return true;
+                case ast_kind::alternate:
+                {
+                    std::size_t alt;
+                    if (!emit(node.children.back(), next, alt))
+                    {
+                        return false;
+                    }
+                    for (std::size_t i = node.children.size()-1; i-- > 0; )
+                    {
+                        std::size_t e;
+                        if (!emit(node.children[i], next, e))
+                        {
+                            return false;
+                        }
+                        alt = add_nfa(nfa_kind::split, 0, e, alt);
+                    }
+                    entry = alt;
+                    return true;
+                }
+                case ast_kind::repeat:
+                {
+                    std::size_t child = node.children[0];
+                    std::size_t tail = next;
+                    if (node.max == no_limit)
+                    {
+                        std::size_t loop = add_nfa(nfa_kind::split, 0, npos, next);
+                        std::size_t body;
+                        if (!emit(child, loop, body))
+                        {
+                            return false;
+                        }
+                        nfa_[loop].out1 = body;
+                        tail = loop;
+                    }
+                    else
+                    {
+                        for (std::size_t i = node.min; i < node.max; ++i)
+                        {
+                            std::size_t body;
+                            if (!emit(child, tail, body))
+                            {
+                                return false;
+                            }
+                            tail = add_nfa(nfa_kind::split, 0, body, next);
+                        }
+                    }
+                    for (std::size_t i = 0; i < node.min; ++i)
+                    {
+                        if (!emit(child, tail, tail))
+                        {
+                            return false;
+                        }
+                    }
+                    entry = tail;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // subset construction
+
+        // Adds the nodes reachable from node without consuming input. '^' is passed only at
+        // the start, '$' only at the end of the input.
+        void closure(std::size_t node, bool at_start, bool at_end, std::vector<uint8_t>& visited, std::vector<std::size_t>& result) const
+        {
+            std::vector<std::size_t> stack;
+            stack.push_back(node);
+            while (!stack.empty())
+            {
+                std::size_t n = stack.back();
+                stack.pop_back();
+                if (n == npos || visited[n])
+                {
+                    continue;
+                }
+                visited[n] = 1;
+                const nfa_node& nn = nfa_[n];
+                switch (nn.kind)
+                {
+                    case nfa_kind::split:
+                        stack.push_back(nn.out2);
+                        stack.push_back(nn.out1);
+                        break;
+                    case nfa_kind::bol:
+                        if (at_start)
+                        {
+                            stack.push_back(nn.out1);
+                        }
+                        break;
+                    case nfa_kind::eol:
+                        result.push_back(n);
+                        if (at_end)
+                        {
+                            stack.push_back(nn.out1);
+                        }
+                        break;
+                    default:
+                        result.push_back(n);
+                        break;
+                }
+            }
+        }
+
+        bool contains_match(const std::vector<std::size_t>& nodes) const
+        {
+            for (auto n : nodes)
+            {
+                if (nfa_[n].kind == nfa_kind::match)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Whether the input may end in this state, following '$'
+        bool matches_at_end(const std::vector<std::size_t>& nodes, bool at_start) const
+        {
+            std::vector<uint8_t> visited(nfa_.size(), 0);
+            std::vector<std::size_t> reached;
+            for (auto n : nodes)
+            {
+                closure(n, at_start, true, visited, reached);
+            }
+            return contains_match(reached);
+        }
+
+        void make_classes()
+        {
+            std::map<std::vector<bool>,uint8_t> signatures;
+            for (unsigned b = 0; b < 256; ++b)
+            {
+                std::vector<bool> signature(sets_.size());
+                for (std::size_t i = 0; i < sets_.size(); ++i)
+                {
+                    signature[i] = sets_[i].test(b);
+                }
+                auto it = signatures.find(signature);
+                if (it == signatures.end())
+                {
+                    it = signatures.emplace(std::move(signature), static_cast<uint8_t>(signatures.size())).first;
+                }
+                classes_[b] = it->second;
+            }
+            class_count_ = signatures.size();
+        }
+
+        bool build_dfa(std::size_t start)
+        {
+            make_classes();
+            unsigned char representative[256];
+            for (unsigned b = 256; b-- > 0; )
+            {
+                representative[classes_[b]] = static_cast<unsigned char>(b);
+            }
+
+            // a search may begin at any position, so the start nodes (without '^') are
+            // part of every state
+            std::vector<std::size_t> restart;
+            {
+                std::vector<uint8_t> visited(nfa_.size(), 0);
+                closure(start, false, false, visited, restart);
+            }
+
+            std::vector<std::size_t> initial;
+            {
+                std::vector<uint8_t> visited(nfa_.size(), 0);
+                closure(start, true, false, visited, initial);
+                std::sort(initial.begin(), initial.end());
+            }
+            accepts_empty_input_ = matches_at_end(initial, true);
+
+            std::map<std::vector<std::size_t>,int32_t> ids;
+            std::vector<std::vector<std::size_t>> states;
+            ids.emplace(initial, 0);
+            states.push_back(initial);
+
+            for (std::size_t s = 0; s < states.size(); ++s)
+            {
+                const std::vector<std::size_t> nodes = states[s];
+                accepts_.push_back(contains_match(nodes) ? 1 : 0);
+                accepts_at_end_.push_back(matches_at_end(nodes, false) ? 1 : 0);
+                for (std::size_t cls = 0; cls < class_count_; ++cls)
+                {
+                    unsigned char b = representative[cls];
+                    std::vector<uint8_t> visited(nfa_.size(), 0);
+                    std::vector<std::size_t> next;
+                    for (auto n : nodes)
+                    {
+                        const nfa_node& nn = nfa_[n];
+                        if (nn.kind == nfa_kind::chars && sets_[nn.set].test(b))
+                        {
+                            closure(nn.out1, false, false, visited, next);
+                        }
+                    }
+                    int32_t id = -1;
+                    if (!next.empty() || !restart.empty())
+                    {
+                        for (auto n : restart)
+                        {
+                            if (!visited[n])
+                            {
+                                visited[n] = 1;
+                                next.push_back(n);
+                            }
+                        }
+                        std::sort(next.begin(), next.end());
+                        auto it = ids.find(next);
+                        if (it == ids.end())
+                        {
+                            if (states.size() >= max_dfa_size)
+                            {
+                                return false;
+                            }
+                            it = ids.emplace(next, static_cast<int32_t>(states.size())).first;
+                            states.push_back(std::move(next));
+                        }
+                        id = it->second;
+                    }
+                    transitions_.push_back(id);
+                }
+            }
+            return true;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
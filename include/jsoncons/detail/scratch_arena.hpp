@@ -0,0 +1,217 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SCRATCH_ARENA_HPP
+#define JSONCONS_DETAIL_SCRATCH_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new> // ::operator new, placement new
+#include <vector>
+#include <type_traits> // std::is_trivially_destructible
+#include <utility> // std::forward
+#include <jsoncons/config/compiler_support.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // Short lived objects created during one evaluation, constructed in blocks that are kept
+    // for reuse. Objects are destroyed in reverse order by rewind(mark), which returns the
+    // arena to the state it was in when mark() was called, so nested users share one arena
+    // as long as they rewind in stack order.
+    class scratch_arena
+    {
+        struct block
+        {
+            char* data;
+            std::size_t size;
+        };
+
+        struct destroy_header
+        {
+            destroy_header* next;
+            void (*destroy)(void*);
+        };
+
+        static constexpr std::size_t initial_block_size = 4096;
+        static constexpr std::size_t max_block_size = 1024*1024;
+        static constexpr std::size_t max_retained_bytes = 4*1024*1024;
+
+        std::vector<block> blocks_;
+        std::size_t block_index_;
+        std::size_t offset_;
+        destroy_header* destroy_list_;
+        std::size_t object_count_;
+        std::size_t reserved_bytes_;
+    public:
+        struct mark_type
+        {
+            std::size_t block_index;
+            std::size_t offset;
+            destroy_header* destroy_list;
+            std::size_t object_count;
+        };
+
+        scratch_arena() noexcept
+            : block_index_(0), offset_(0), destroy_list_(nullptr), object_count_(0), reserved_bytes_(0)
+        {
+        }
+
+        scratch_arena(const scratch_arena&) = delete;
+        scratch_arena& operator=(const scratch_arena&) = delete;
+
+        ~scratch_arena() noexcept
+        {
+            rewind(mark_type{0, 0, nullptr, 0});
+            for (auto& b : blocks_)
+            {
+                ::operator delete(b.data);
+            }
+        }
+
+        mark_type mark() const noexcept
+        {
+            return mark_type{block_index_, offset_, destroy_list_, object_count_};
+        }
+
+        // Destroys the objects created since m was taken, newest first, and makes their memory
+        // available again. When the arena becomes empty, blocks beyond max_retained_bytes are freed.
+        void rewind(const mark_type& m) noexcept
+        {
+            while (destroy_list_ != m.destroy_list)
+            {
+                destroy_header* h = destroy_list_;
+                destroy_list_ = h->next;
+                h->destroy(object_after(h));
+            }
+            block_index_ = m.block_index;
+            offset_ = m.offset;
+            object_count_ = m.object_count;
+
+            if (block_index_ == 0 && offset_ == 0)
+            {
+                while (reserved_bytes_ > max_retained_bytes && blocks_.size() > 1)
+                {
+                    reserved_bytes_ -= blocks_.back().size;
+                    ::operator delete(blocks_.back().data);
+                    blocks_.pop_back();
+                }
+            }
+        }
+
+        template <class T,class... Args>
+        T* create(Args&& ... args)
+        {
+            return create_object<T>(std::is_trivially_destructible<T>(), std::forward<Args>(args)...);
+        }
+
+        // Number of objects created since construction, less those rewound
+        std::size_t object_count() const noexcept
+        {
+            return object_count_;
+        }
+
+        // Number of blocks allocated and kept, each one an allocation that the objects share
+        std::size_t block_count() const noexcept
+        {
+            return blocks_.size();
+        }
+
+        // The arena for the calling thread
+        static scratch_arena& thread_instance()
+        {
+            static thread_local scratch_arena arena;
+            return arena;
+        }
+    private:
+        template <class T,class... Args>
+        T* create_object(std::true_type, Args&& ... args)
+        {
+            void* p = allocate(sizeof(T), alignof(T));
+            T* obj = ::new(p) T(std::forward<Args>(args)...);
+            ++object_count_;
+            return obj;
+        }
+
+        template <class T,class... Args>
+        T* create_object(std::false_type, Args&& ... args)
+        {
+            constexpr std::size_t alignment = alignof(T) > alignof(destroy_header) ? alignof(T) : alignof(destroy_header);
+            constexpr std::size_t header_size = (sizeof(destroy_header) + alignment - 1) & ~(alignment - 1);
+
+            // save the position, so that a throwing constructor leaves no trace
+            mark_type m = mark();
+            char* p = static_cast<char*>(allocate(header_size + sizeof(T), alignment));
+            T* obj;
+            JSONCONS_TRY
+            {
+                obj = ::new(p + header_size) T(std::forward<Args>(args)...);
+            }
+            JSONCONS_CATCH(...)
+            {
+                rewind(m);
+                JSONCONS_RETHROW;
+            }
+            destroy_header* h = ::new(p + header_size - sizeof(destroy_header)) destroy_header{destroy_list_, &destroy<T>};
+            destroy_list_ = h;
+            ++object_count_;
+            return obj;
+        }
+
+        template <class T>
+        static void destroy(void* p) noexcept
+        {
+            static_cast<T*>(p)->~T();
+        }
+
+        // The object that follows a header, the header always immediately precedes it
+        static void* object_after(destroy_header* h) noexcept
+        {
+            return reinterpret_cast<char*>(h) + sizeof(destroy_header);
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment)
+        {
+            while (block_index_ < blocks_.size())
+            {
+                block& b = blocks_[block_index_];
+                std::size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+                if (aligned + size <= b.size)
+                {
+                    offset_ = aligned + size;
+                    return b.data + aligned;
+                }
+                if (block_index_ + 1 == blocks_.size())
+                {
+                    break;
+                }
+                ++block_index_;
+                offset_ = 0;
+            }
+
+            std::size_t block_size = blocks_.empty() ? initial_block_size : blocks_.back().size*2;
+            if (block_size > max_block_size)
+            {
+                block_size = max_block_size;
+            }
+            if (block_size < size + alignment)
+            {
+                block_size = size + alignment;
+            }
+            // ::operator new memory is aligned for any fundamental type
+            blocks_.reserve(blocks_.size() + 1);
+            blocks_.push_back(block{static_cast<char*>(::operator new(block_size)), block_size});
+            reserved_bytes_ += block_size;
+            block_index_ = blocks_.size() - 1;
+            offset_ = size;
+            return blocks_.back().data;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,252 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STRING_SCAN_HPP
+#define JSONCONS_DETAIL_STRING_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <jsoncons/config/compiler_support.hpp>
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)
+#  include <immintrin.h>
+#elif defined(JSONCONS_HAS_NEON)
+#  include <arm_neon.h>
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    // x must not be zero
+    inline int trailing_zeros(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+    #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+#if defined(JSONCONS_HAS_NEON)
+    // Four bits per byte of the comparison result m
+    inline uint64_t neon_nibble_mask(uint8x16_t m)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+    }
+#endif
+
+    // Returns a pointer to the first '\"', '\\' or control character in [first,last), or last if there is none.
+    // Sets non_ascii to true if any byte before the returned position is not ASCII.
+
+    inline const char* skip_string_chars(const char* first, const char* last, bool& non_ascii)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i max_control = _mm256_set1_epi8(0x1f);
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i s = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                            _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control));
+                uint32_t special = static_cast<uint32_t>(_mm256_movemask_epi8(s));
+                uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+                if (special != 0)
+                {
+                    int n = trailing_zeros(special);
+                    if ((high & ((uint32_t(1) << n) - 1)) != 0)
+                    {
+                        non_ascii = true;
+                    }
+                    return first + n;
+                }
+                if (high != 0)
+                {
+                    non_ascii = true;
+                }
+                first += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i max_control = _mm_set1_epi8(0x1f);
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i s = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                         _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control));
+                uint32_t special = static_cast<uint32_t>(_mm_movemask_epi8(s));
+                uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(v));
+                if (special != 0)
+                {
+                    int n = trailing_zeros(special);
+                    if ((high & ((uint32_t(1) << n) - 1)) != 0)
+                    {
+                        non_ascii = true;
+                    }
+                    return first + n;
+                }
+                if (high != 0)
+                {
+                    non_ascii = true;
+                }
+                first += 16;
+            }
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        {
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t backslash = vdupq_n_u8('\\');
+            const uint8x16_t max_control = vdupq_n_u8(0x1f);
+            const uint8x16_t max_ascii = vdupq_n_u8(0x7f);
+            while (last - first >= 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+                uint8x16_t s = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcleq_u8(v, max_control));
+                uint64_t special = neon_nibble_mask(s);
+                uint64_t high = neon_nibble_mask(vcgtq_u8(v, max_ascii));
+                if (special != 0)
+                {
+                    int n = trailing_zeros(special);
+                    if ((high & ((uint64_t(1) << n) - 1)) != 0)
+                    {
+                        non_ascii = true;
+                    }
+                    return first + n/4;
+                }
+                if (high != 0)
+                {
+                    non_ascii = true;
+                }
+                first += 16;
+            }
+        }
+    #endif
+        for (; first < last; ++first)
+        {
+            const uint8_t c = static_cast<uint8_t>(*first);
+            if (c == '\"' || c == '\\' || c < 0x20)
+            {
+                return first;
+            }
+            if (c >= 0x80)
+            {
+                non_ascii = true;
+            }
+        }
+        return last;
+    }
+
+    // Returns a pointer to the first character in [first,last) that a JSON encoder must escape, or last if there is none.
+    // These are '\"', '\\', control characters and DEL, '/' if escape_solidus is set,
+    // and bytes of multi-byte sequences if escape_all_non_ascii is set.
+
+    inline const char* find_escape_char(const char* first, const char* last,
+                                        bool escape_all_non_ascii, bool escape_solidus)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i solidus = escape_solidus ? _mm256_set1_epi8('/') : quote;
+            const __m256i del = _mm256_set1_epi8(0x7f);
+            const __m256i max_control = _mm256_set1_epi8(0x1f);
+            const uint32_t high_mask = escape_all_non_ascii ? 0xffffffff : 0;
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i s = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(v, solidus), _mm256_cmpeq_epi8(v, del)));
+                s = _mm256_or_si256(s, _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control));
+                uint32_t special = static_cast<uint32_t>(_mm256_movemask_epi8(s)) |
+                                   (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & high_mask);
+                if (special != 0)
+                {
+                    return first + trailing_zeros(special);
+                }
+                first += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i solidus = escape_solidus ? _mm_set1_epi8('/') : quote;
+            const __m128i del = _mm_set1_epi8(0x7f);
+            const __m128i max_control = _mm_set1_epi8(0x1f);
+            const uint32_t high_mask = escape_all_non_ascii ? 0xffff : 0;
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i s = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                         _mm_or_si128(_mm_cmpeq_epi8(v, solidus), _mm_cmpeq_epi8(v, del)));
+                s = _mm_or_si128(s, _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control));
+                uint32_t special = static_cast<uint32_t>(_mm_movemask_epi8(s)) |
+                                   (static_cast<uint32_t>(_mm_movemask_epi8(v)) & high_mask);
+                if (special != 0)
+                {
+                    return first + trailing_zeros(special);
+                }
+                first += 16;
+            }
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        {
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t backslash = vdupq_n_u8('\\');
+            const uint8x16_t solidus = escape_solidus ? vdupq_n_u8('/') : quote;
+            const uint8x16_t max_control = vdupq_n_u8(0x1f);
+            // DEL, and when escaping all non ascii, every byte above DEL
+            const uint8x16_t min_escaped = vdupq_n_u8(0x7f);
+            const uint8x16_t max_escaped = escape_all_non_ascii ? vdupq_n_u8(0xff) : min_escaped;
+            while (last - first >= 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+                uint8x16_t s = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vceqq_u8(v, solidus));
+                s = vorrq_u8(s, vcleq_u8(v, max_control));
+                s = vorrq_u8(s, vandq_u8(vcgeq_u8(v, min_escaped), vcleq_u8(v, max_escaped)));
+                uint64_t special = neon_nibble_mask(s);
+                if (special != 0)
+                {
+                    return first + trailing_zeros(special)/4;
+                }
+                first += 16;
+            }
+        }
+    #endif
+        for (; first < last; ++first)
+        {
+            const uint8_t c = static_cast<uint8_t>(*first);
+            if (c == '\"' || c == '\\' || c <= 0x1f || c == 0x7f || (escape_solidus && c == '/') || (escape_all_non_ascii && c >= 0x80))
+            {
+                return first;
+            }
+        }
+        return last;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -17,6 +17,7 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/ryu.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 #include <jsoncons/more_type_traits.hpp>
 
@@ -303,7 +304,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*e", precision2, val);
@@ -336,7 +337,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*g", precision2, val);
@@ -403,7 +404,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*f", precision2, val);
@@ -460,6 +461,47 @@ namespace detail {
         return dtoa_general(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
     }
 
+    // Same layout as dtoa_general, but with the shortest digits that round trip 
+    // in all cases, without falling back to snprintf
+    template<class Result>
+    bool dtoa_shortest(double v, char, Result& result, std::true_type)
+    {
+        if (v == 0)
+        {
+            result.push_back('0');
+            result.push_back('.');
+            result.push_back('0');
+            return true;
+        }
+
+        int length = 0;
+        int k;
+
+        char buffer[32];
+
+        if (std::signbit(v))
+        {
+            result.push_back('-');
+            v = -v;
+        }
+        jsoncons::detail::ryu_shortest(v, buffer, &length, &k);
+        jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
+        return true;
+    }
+
+    // ryu_shortest relies on the IEEE 754 binary64 layout
+    template<class Result>
+    bool dtoa_shortest(double v, char decimal_point, Result& result, std::false_type)
+    {
+        return dtoa_general(v, decimal_point, result, std::false_type());
+    }
+
+    template<class Result>
+    bool dtoa_shortest(double v, char decimal_point, Result& result)
+    {
+        return dtoa_shortest(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
+    }
+
     class write_double
     {
     private:
@@ -553,9 +595,15 @@ namespace detail {
                     }             
                     break;
                 }
-                default:
+            case float_chars_format::shortest:
+                if (!dtoa_shortest(val, decimal_point_, result))
+                {
                     JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                    break;
+                }
+                break;
+            default:
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
+                break;
             }
             return count;
         }
@@ -0,0 +1,232 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ARENA_HPP
+#define JSONCONS_JSON_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new> // ::operator new, placement new
+#include <memory> // std::allocator_traits
+#include <type_traits> // std::true_type, std::decay
+#include <utility> // std::forward
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/json_exception.hpp>
+
+namespace jsoncons {
+
+    // Hands out memory from a list of chunks by bumping a pointer. Deallocation is a no-op,
+    // all memory is released at once by release() or the destructor.
+    class json_arena
+    {
+        struct chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+        static constexpr std::size_t max_chunk_size = 1024*1024;
+
+        chunk* head_;
+        char* current_;
+        char* end_;
+        std::size_t next_chunk_size_;
+        std::size_t initial_chunk_size_;
+        std::size_t allocation_count_;
+        std::size_t bytes_allocated_;
+        std::size_t bytes_reserved_;
+        std::size_t chunk_count_;
+    public:
+        explicit json_arena(std::size_t initial_chunk_size = 4096) noexcept
+            : head_(nullptr), current_(nullptr), end_(nullptr),
+              next_chunk_size_(initial_chunk_size > 0 ? initial_chunk_size : 1),
+              initial_chunk_size_(next_chunk_size_),
+              allocation_count_(0), bytes_allocated_(0), bytes_reserved_(0), chunk_count_(0)
+        {
+        }
+
+        json_arena(const json_arena&) = delete;
+        json_arena& operator=(const json_arena&) = delete;
+
+        ~json_arena() noexcept
+        {
+            release();
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment)
+        {
+            JSONCONS_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+            char* p = align(current_, alignment);
+            if (p == nullptr || size > static_cast<std::size_t>(end_ - p))
+            {
+                add_chunk(size + alignment - 1);
+                p = align(current_, alignment);
+            }
+            current_ = p + size;
+            ++allocation_count_;
+            bytes_allocated_ += size;
+            return p;
+        }
+
+        // Frees every chunk. Memory handed out earlier must no longer be used.
+        void release() noexcept
+        {
+            while (head_ != nullptr)
+            {
+                chunk* next = head_->next;
+                ::operator delete(head_);
+                head_ = next;
+            }
+            current_ = nullptr;
+            end_ = nullptr;
+            next_chunk_size_ = initial_chunk_size_;
+            allocation_count_ = 0;
+            bytes_allocated_ = 0;
+            bytes_reserved_ = 0;
+            chunk_count_ = 0;
+        }
+
+        // Moves value (or copies it, if an lvalue) into the arena and returns a reference to it.
+        // The value is never destroyed, its memory is released with the arena's, so tearing down
+        // a large document costs nothing beyond freeing the chunks. Everything the value owns must have been allocated from this arena.
+        template <class Json>
+        typename std::decay<Json>::type& adopt(Json&& value)
+        {
+            using value_type = typename std::decay<Json>::type;
+
+            void* p = allocate(sizeof(value_type), alignof(value_type));
+            return *(::new(p) value_type(std::forward<Json>(value)));
+        }
+
+        // Number of calls to allocate since construction or the last release
+        std::size_t allocation_count() const noexcept
+        {
+            return allocation_count_;
+        }
+
+        // Total bytes requested by those calls
+        std::size_t bytes_allocated() const noexcept
+        {
+            return bytes_allocated_;
+        }
+
+        // Total bytes held in chunks, including unused space and chunk headers
+        std::size_t bytes_reserved() const noexcept
+        {
+            return bytes_reserved_;
+        }
+
+        std::size_t chunk_count() const noexcept
+        {
+            return chunk_count_;
+        }
+    private:
+        static char* align(char* p, std::size_t alignment) noexcept
+        {
+            if (p == nullptr)
+            {
+                return nullptr;
+            }
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+            std::uintptr_t aligned = (address + (alignment - 1)) & ~static_cast<std::uintptr_t>(alignment - 1);
+            return p + (aligned - address);
+        }
+
+        void add_chunk(std::size_t min_size)
+        {
+            std::size_t size = next_chunk_size_ < min_size ? min_size : next_chunk_size_;
+            if (next_chunk_size_ < max_chunk_size)
+            {
+                next_chunk_size_ *= 2;
+            }
+            const std::size_t header_size = (sizeof(chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+            chunk* c = static_cast<chunk*>(::operator new(header_size + size));
+            c->next = head_;
+            c->size = header_size + size;
+            head_ = c;
+            current_ = reinterpret_cast<char*>(c) + header_size;
+            end_ = current_ + size;
+            bytes_reserved_ += c->size;
+            ++chunk_count_;
+        }
+    };
+
+    // A stateful allocator that allocates from a json_arena. A default constructed
+    // arena_allocator has no arena and uses ::operator new and ::operator delete.
+    template <class T>
+    class arena_allocator
+    {
+        template <class U>
+        friend class arena_allocator;
+
+        json_arena* arena_;
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        template <class U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+
+        arena_allocator() noexcept
+            : arena_(nullptr)
+        {
+        }
+
+        arena_allocator(json_arena& arena) noexcept
+            : arena_(std::addressof(arena))
+        {
+        }
+
+        template <class U>
+        arena_allocator(const arena_allocator<U>& other) noexcept
+            : arena_(other.arena_)
+        {
+        }
+
+        json_arena* arena() const noexcept
+        {
+            return arena_;
+        }
+
+        T* allocate(size_type n)
+        {
+            if (arena_ == nullptr)
+            {
+                return static_cast<T*>(::operator new(n*sizeof(T)));
+            }
+            return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_type) noexcept
+        {
+            if (arena_ == nullptr)
+            {
+                ::operator delete(p);
+            }
+        }
+
+        friend bool operator==(const arena_allocator& lhs, const arena_allocator& rhs) noexcept
+        {
+            return lhs.arena_ == rhs.arena_;
+        }
+
+        friend bool operator!=(const arena_allocator& lhs, const arena_allocator& rhs) noexcept
+        {
+            return lhs.arena_ != rhs.arena_;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
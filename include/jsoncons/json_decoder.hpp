@@ -13,8 +13,10 @@
 #include <memory> // std::allocator
 #include <iterator> // std::make_move_iterator
 #include <utility> // std::move
+#include <functional> // std::less_equal
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_arena.hpp>
 
 namespace jsoncons {
 
@@ -80,6 +82,8 @@ private:
     std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
     bool is_valid_;
+    const char_type* source_first_ = nullptr;
+    const char_type* source_last_ = nullptr;
 
 public:
     json_decoder(const temp_allocator_type& temp_alloc = temp_allocator_type())
@@ -127,6 +131,15 @@ public:
         structure_stack_.emplace_back(structure_type::root_t, 0);
     }
 
+    // Parses into memory allocated from arena, for Json types that allocate with arena_allocator
+    template <class Alloc = result_allocator_type,
+              class = typename std::enable_if<std::is_constructible<Alloc,json_arena&>::value>::type>
+    json_decoder(json_arena& arena,
+                 const temp_allocator_type& temp_alloc = temp_allocator_type())
+        : json_decoder(result_allocator_arg, result_allocator_type(arena), temp_alloc)
+    {
+    }
+
     void reset()
     {
         is_valid_ = false;
@@ -140,6 +153,14 @@ public:
         return is_valid_;
     }
 
+    // String values that lie within source are stored as views into it rather than copied,
+    // source must outlive the result
+    void string_view_source(const string_view_type& source)
+    {
+        source_first_ = source.data();
+        source_last_ = source.data() + source.size();
+    }
+
     Json get_result()
     {
         JSONCONS_ASSERT(is_valid_);
@@ -254,6 +275,21 @@ private:
 
     bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
     {
+        if (is_in_source(sv))
+        {
+            switch (structure_stack_.back().type_)
+            {
+                case structure_type::object_t:
+                case structure_type::array_t:
+                    item_stack_.emplace_back(std::forward<key_type>(name_), string_view_arg, sv, tag);
+                    break;
+                case structure_type::root_t:
+                    result_ = Json(string_view_arg, sv, tag);
+                    is_valid_ = true;
+                    return false;
+            }
+            return true;
+        }
         switch (structure_stack_.back().type_)
         {
             case structure_type::object_t:
@@ -268,6 +304,13 @@ private:
         return true;
     }
 
+    bool is_in_source(const string_view_type& sv) const
+    {
+        std::less_equal<const char_type*> le;
+        return source_first_ != nullptr && sv.data() != nullptr && 
+               le(source_first_, sv.data()) && le(sv.data() + sv.size(), source_last_);
+    }
+
     bool visit_byte_string(const byte_string_view& b, 
                            semantic_tag tag, 
                            const ser_context&,
@@ -23,6 +23,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/string_scan.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -39,6 +40,24 @@ namespace detail {
         return cp >= 0x80;
     }
 
+    // Returns a pointer to the first character in [first,last) that escape_string must examine
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+    find_escape_char(const CharT* first, const CharT* last,
+                     bool escape_all_non_ascii, bool escape_solidus)
+    {
+        const char* p = reinterpret_cast<const char*>(first);
+        return first + (find_escape_char(p, p + (last - first), escape_all_non_ascii, escape_solidus) - p);
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+    find_escape_char(const CharT* first, const CharT*, bool, bool)
+    {
+        return first;
+    }
+
     template <class CharT, class Sink>
     std::size_t escape_string(const CharT* s, std::size_t length,
                          bool escape_all_non_ascii, bool escape_solidus,
@@ -49,6 +68,17 @@ namespace detail {
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            const CharT* run_end = find_escape_char(it, end, escape_all_non_ascii, escape_solidus);
+            if (run_end != it)
+            {
+                sink.append(it, static_cast<std::size_t>(run_end - it));
+                count += static_cast<std::size_t>(run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
             CharT c = *it;
             switch (c)
             {
@@ -0,0 +1,415 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility> // std::move
+#include <jsoncons/source.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+class json_lines_options
+{
+    std::size_t thread_count_;
+    std::size_t max_queue_depth_;
+    std::size_t chunk_size_;
+    bool ordered_;
+public:
+    json_lines_options()
+        : thread_count_(0), max_queue_depth_(0), chunk_size_(1024*1024), ordered_(true)
+    {
+    }
+
+    // Number of worker threads, 0 for std::thread::hardware_concurrency()
+    std::size_t thread_count() const
+    {
+        return thread_count_;
+    }
+
+    json_lines_options& thread_count(std::size_t value)
+    {
+        thread_count_ = value;
+        return *this;
+    }
+
+    // Maximum number of chunks read ahead and not yet delivered, 0 for twice the thread count
+    std::size_t max_queue_depth() const
+    {
+        return max_queue_depth_;
+    }
+
+    json_lines_options& max_queue_depth(std::size_t value)
+    {
+        max_queue_depth_ = value;
+        return *this;
+    }
+
+    // Approximate size of a chunk in characters, a chunk always ends at a newline
+    std::size_t chunk_size() const
+    {
+        return chunk_size_;
+    }
+
+    json_lines_options& chunk_size(std::size_t value)
+    {
+        chunk_size_ = value;
+        return *this;
+    }
+
+    // Whether documents are delivered in input order, or as soon as their chunk is parsed
+    bool ordered() const
+    {
+        return ordered_;
+    }
+
+    json_lines_options& ordered(bool value)
+    {
+        ordered_ = value;
+        return *this;
+    }
+};
+
+template <class Json,class Source=jsoncons::stream_source<typename Json::char_type>>
+class json_lines_reader
+{
+public:
+    using char_type = typename Json::char_type;
+    using source_type = Source;
+private:
+    using string_type = std::basic_string<char_type>;
+
+    struct chunk
+    {
+        string_type text;
+        std::size_t first_line = 0;
+        std::vector<std::pair<Json,std::size_t>> documents;
+        std::exception_ptr error;
+        bool ready = false;
+    };
+
+    source_type source_;
+    json_lines_options options_;
+    basic_json_decode_options<char_type> decode_options_;
+
+    std::vector<chunk> chunks_;
+    std::vector<std::size_t> free_chunks_;
+    std::deque<std::size_t> pending_;   // parsed by the workers in this order
+    std::deque<std::size_t> in_flight_; // submitted and not yet delivered, in input order
+    std::deque<std::size_t> completed_; // parsed, in completion order
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_;
+
+    // Noncopyable and nonmoveable
+    json_lines_reader(const json_lines_reader&) = delete;
+    json_lines_reader& operator=(const json_lines_reader&) = delete;
+public:
+    template <class Sourceable>
+    explicit json_lines_reader(Sourceable&& source,
+                               const json_lines_options& options = json_lines_options(),
+                               const basic_json_decode_options<char_type>& decode_options = basic_json_decode_options<char_type>())
+        : source_(std::forward<Sourceable>(source)),
+          options_(options),
+          decode_options_(decode_options),
+          stop_(false)
+    {
+    }
+
+    // Calls f(document, line) for every non-blank line of the input, on the calling thread.
+    // Throws ser_error, with the line of the input, if a line fails to parse.
+    void read(std::function<void(Json&&,std::size_t)> f)
+    {
+        std::size_t thread_count = options_.thread_count();
+        if (thread_count == 0)
+        {
+            thread_count = std::thread::hardware_concurrency();
+            if (thread_count == 0)
+            {
+                thread_count = 1;
+            }
+        }
+        std::size_t depth = options_.max_queue_depth() == 0 ? 2*thread_count : options_.max_queue_depth();
+
+        chunks_.clear();
+        chunks_.resize(depth);
+        free_chunks_.clear();
+        for (std::size_t i = depth; i > 0; --i)
+        {
+            free_chunks_.push_back(i-1);
+        }
+        pending_.clear();
+        in_flight_.clear();
+        completed_.clear();
+        stop_ = false;
+
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count);
+        JSONCONS_TRY
+        {
+            for (std::size_t i = 0; i < thread_count; ++i)
+            {
+                workers.emplace_back([this](){work();});
+            }
+            deliver_all(f);
+        }
+        JSONCONS_CATCH(...)
+        {
+            stop_workers(workers);
+            JSONCONS_RETHROW;
+        }
+        stop_workers(workers);
+    }
+
+    // Replays every document to visitor, in the order given by the options
+    void read(basic_json_visitor<char_type>& visitor)
+    {
+        read([&visitor](Json&& j, std::size_t){j.dump(visitor);});
+    }
+
+private:
+    void deliver_all(std::function<void(Json&&,std::size_t)>& f)
+    {
+        string_type carry;
+        std::size_t line = 1;
+        bool bof = true;
+        bool input_done = false;
+
+        while (true)
+        {
+            while (!input_done && !free_chunks_.empty())
+            {
+                std::size_t index = free_chunks_.back();
+                chunk& c = chunks_[index];
+                input_done = read_chunk(carry, c.text);
+                if (bof)
+                {
+                    skip_bom(c.text);
+                    bof = false;
+                }
+                if (c.text.empty())
+                {
+                    continue;
+                }
+                free_chunks_.pop_back();
+                c.first_line = line;
+                for (auto ch : c.text)
+                {
+                    if (ch == '\n')
+                    {
+                        ++line;
+                    }
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_.push_back(index);
+                in_flight_.push_back(index);
+                work_cv_.notify_one();
+            }
+
+            std::size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (in_flight_.empty())
+                {
+                    break;
+                }
+                if (options_.ordered())
+                {
+                    done_cv_.wait(lock, [this](){return chunks_[in_flight_.front()].ready;});
+                    index = in_flight_.front();
+                    in_flight_.pop_front();
+                }
+                else
+                {
+                    done_cv_.wait(lock, [this](){return !completed_.empty();});
+                    index = completed_.front();
+                    completed_.pop_front();
+                    for (auto it = in_flight_.begin(); it != in_flight_.end(); ++it)
+                    {
+                        if (*it == index)
+                        {
+                            in_flight_.erase(it);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Documents that precede an error in the chunk are still delivered
+            chunk& c = chunks_[index];
+            for (auto& doc : c.documents)
+            {
+                f(std::move(doc.first), doc.second);
+            }
+            if (c.error)
+            {
+                std::rethrow_exception(c.error);
+            }
+            c.documents.clear();
+            c.text.clear();
+            c.ready = false;
+            free_chunks_.push_back(index);
+        }
+        if (source_.is_error())
+        {
+            JSONCONS_THROW(ser_error(json_errc::source_error, line, 1));
+        }
+    }
+
+    // Fills text with whole lines, starting with carry, and leaves the incomplete last line in carry.
+    // Returns true when the source is exhausted.
+    bool read_chunk(string_type& carry, string_type& text)
+    {
+        text.clear();
+        text.swap(carry);
+        std::size_t chunk_size = options_.chunk_size() == 0 ? 1 : options_.chunk_size();
+        bool has_newline = text.find(char_type('\n')) != string_type::npos;
+        while (true)
+        {
+            if (has_newline && text.size() >= chunk_size)
+            {
+                std::size_t last = text.rfind(char_type('\n'));
+                carry.assign(text, last+1, string_type::npos);
+                text.resize(last+1);
+                return false;
+            }
+            if (source_.eof() || source_.is_error())
+            {
+                return true;
+            }
+            std::size_t start = text.size();
+            std::size_t want = chunk_size > start ? chunk_size - start : chunk_size;
+            text.resize(start + want);
+            std::size_t n = source_.read(&text[start], want);
+            text.resize(start + n);
+            if (!has_newline && text.find(char_type('\n'), start) != string_type::npos)
+            {
+                has_newline = true;
+            }
+        }
+    }
+
+    static void skip_bom(string_type& text)
+    {
+        if (sizeof(char_type) == 1 && text.size() >= 3 &&
+            static_cast<uint8_t>(text[0]) == 0xEF && static_cast<uint8_t>(text[1]) == 0xBB && static_cast<uint8_t>(text[2]) == 0xBF)
+        {
+            text.erase(0, 3);
+        }
+    }
+
+    void work()
+    {
+        basic_json_parser<char_type> parser(decode_options_);
+        json_decoder<Json> decoder;
+
+        while (true)
+        {
+            std::size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [this](){return stop_ || !pending_.empty();});
+                if (stop_)
+                {
+                    return;
+                }
+                index = pending_.front();
+                pending_.pop_front();
+            }
+
+            chunk& c = chunks_[index];
+            JSONCONS_TRY
+            {
+                parse_chunk(parser, decoder, c);
+            }
+            JSONCONS_CATCH(...)
+            {
+                c.error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            c.ready = true;
+            if (!options_.ordered())
+            {
+                completed_.push_back(index);
+            }
+            done_cv_.notify_one();
+        }
+    }
+
+    static void parse_chunk(basic_json_parser<char_type>& parser, json_decoder<Json>& decoder, chunk& c)
+    {
+        const char_type* p = c.text.data();
+        const char_type* end = p + c.text.size();
+        std::size_t line = c.first_line;
+
+        while (p < end)
+        {
+            const char_type* eol = p;
+            bool blank = true;
+            for (; eol < end && *eol != '\n'; ++eol)
+            {
+                if (!(*eol == ' ' || *eol == '\t' || *eol == '\r'))
+                {
+                    blank = false;
+                }
+            }
+            if (!blank)
+            {
+                std::error_code ec;
+                parser.reinitialize();
+                decoder.reset();
+                parser.update(p, eol - p);
+                parser.finish_parse(decoder, ec);
+                if (!ec)
+                {
+                    parser.check_done(ec);
+                }
+                if (ec)
+                {
+                    JSONCONS_THROW(ser_error(ec, line, parser.column()));
+                }
+                if (!decoder.is_valid())
+                {
+                    JSONCONS_THROW(ser_error(json_errc::unexpected_eof, line, parser.column()));
+                }
+                c.documents.emplace_back(decoder.get_result(), line);
+            }
+            p = eol < end ? eol + 1 : end;
+            ++line;
+        }
+    }
+
+    void stop_workers(std::vector<std::thread>& workers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& t : workers)
+        {
+            t.join();
+        }
+    }
+};
+
+} // namespace jsoncons
+
+#endif
@@ -12,6 +12,7 @@
 #include <tuple>
 #include <exception>
 #include <cstring>
+#include <cstdint>
 #include <algorithm> // std::sort, std::stable_sort, std::lower_bound, std::unique
 #include <utility>
 #include <initializer_list>
@@ -20,6 +21,7 @@
 #include <utility> // std::move
 #include <cassert> // assert
 #include <type_traits> // std::enable_if
+#include <chrono> // std::chrono::steady_clock
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
 #include <jsoncons/json_array.hpp>
@@ -251,6 +253,275 @@ namespace jsoncons {
     };
 
 
+namespace detail {
+
+    // Final mix of MurmurHash3, so that every bit of h affects the low bits used for the slot
+    inline uint64_t mix_hash_bits(uint64_t h) noexcept
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Chosen once per process from the clock and the (randomized) address of a static,
+    // so that keys that collide in one process cannot be prepared in advance
+    inline uint64_t object_index_seed() noexcept
+    {
+        static const char marker = 0;
+        static const uint64_t seed = mix_hash_bits(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ 
+                                                   static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(&marker)));
+        return seed;
+    }
+
+} // namespace detail
+
+    // Open addressing hash table from the keys of an object's members to their positions.
+    // A slot holds a position plus one, zero marks an empty slot, and the number of slots is a power 
+    // of two, at least twice the number of members. Objects with fewer than threshold members 
+    // have an empty index. The owner passes its members to each call and keeps the index 
+    // in step with them.
+    template <class IndexContainer>
+    class json_object_index
+    {
+    public:
+        using allocator_type = typename IndexContainer::allocator_type;
+
+        static constexpr std::size_t threshold = 16;
+    private:
+        IndexContainer slots_;
+    public:
+        json_object_index()
+        {
+        }
+
+        explicit json_object_index(const allocator_type& alloc)
+            : slots_(alloc)
+        {
+        }
+
+        json_object_index(const json_object_index& other, const allocator_type& alloc)
+            : slots_(other.slots_, alloc)
+        {
+        }
+
+        json_object_index(json_object_index&& other, const allocator_type& alloc)
+            : slots_(std::move(other.slots_), alloc)
+        {
+        }
+
+        json_object_index(const json_object_index&) = default;
+        json_object_index(json_object_index&&) = default;
+        json_object_index& operator=(const json_object_index&) = default;
+        json_object_index& operator=(json_object_index&&) = default;
+
+        bool empty() const
+        {
+            return slots_.empty();
+        }
+
+        void clear()
+        {
+            slots_.clear();
+        }
+
+        void shrink_to_fit()
+        {
+            slots_.shrink_to_fit();
+        }
+
+        void swap(json_object_index& other) noexcept
+        {
+            slots_.swap(other.slots_);
+        }
+
+        // Returns the position of the member with this key, or size if there is none.
+        // The index must not be empty.
+        template <class Iterator, class StringView>
+        std::size_t find(Iterator members, std::size_t size, const StringView& key) const noexcept
+        {
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t slot = hash_key(key) & mask; slots_[slot] != 0; slot = (slot + 1) & mask)
+            {
+                if (members[slots_[slot] - 1].key() == key)
+                {
+                    return slots_[slot] - 1;
+                }
+            }
+            return size;
+        }
+
+        template <class Iterator>
+        void build(Iterator members, std::size_t size)
+        {
+            if (size < threshold)
+            {
+                slots_.clear();
+            }
+            else
+            {
+                allocate(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    add(hash_key(members[i].key()), i);
+                }
+            }
+        }
+
+        // Adds the member at pos, after it has been inserted. The member's key must be unique.
+        template <class Iterator>
+        void insert(Iterator members, std::size_t size, std::size_t pos)
+        {
+            JSONCONS_ASSERT(pos < size);
+
+            if (slots_.empty() ? size >= threshold : 2*size > slots_.size())
+            {
+                build(members, size);
+                return;
+            }
+            if (slots_.empty())
+            {
+                return;
+            }
+            if (pos + 1 < size)
+            {
+                for (auto& entry : slots_)
+                {
+                    if (entry > pos)
+                    {
+                        ++entry;
+                    }
+                }
+            }
+            add(hash_key(members[pos].key()), pos);
+        }
+
+        // Removes the members in [pos1,pos2), before they are erased
+        template <class Iterator>
+        void erase(Iterator members, std::size_t size, std::size_t pos1, std::size_t pos2)
+        {
+            JSONCONS_ASSERT(pos1 <= pos2);
+            JSONCONS_ASSERT(pos2 <= size);
+
+            if (slots_.empty())
+            {
+                return;
+            }
+            if (size - (pos2 - pos1) < threshold)
+            {
+                slots_.clear();
+                return;
+            }
+
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t pos = pos1; pos < pos2; ++pos)
+            {
+                std::size_t slot = hash_key(members[pos].key()) & mask;
+                while (slots_[slot] != pos + 1)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                // Backward shift deletion, move up entries that were displaced past the emptied slot
+                std::size_t next = (slot + 1) & mask;
+                while (slots_[next] != 0)
+                {
+                    std::size_t home = hash_key(members[slots_[next] - 1].key()) & mask;
+                    if (((next - home) & mask) >= ((next - slot) & mask))
+                    {
+                        slots_[slot] = slots_[next];
+                        slot = next;
+                    }
+                    next = (next + 1) & mask;
+                }
+                slots_[slot] = 0;
+            }
+            if (pos2 < size)
+            {
+                const std::size_t offset = pos2 - pos1;
+                for (auto& entry : slots_)
+                {
+                    if (entry > pos2)
+                    {
+                        entry -= offset;
+                    }
+                }
+            }
+        }
+
+        // Moves the first member with each key to the front, preserving order, and builds the index 
+        // over them. Returns their number, the caller erases the members that follow.
+        template <class Iterator>
+        std::size_t remove_duplicates(Iterator members, std::size_t size)
+        {
+            allocate(size);
+
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                std::size_t slot = hash_key(members[i].key()) & mask;
+                bool duplicate = false;
+                while (!duplicate && slots_[slot] != 0)
+                {
+                    duplicate = members[slots_[slot] - 1].key() == members[i].key();
+                    slot = (slot + 1) & mask;
+                }
+                if (!duplicate)
+                {
+                    if (count != i)
+                    {
+                        members[count] = std::move(members[i]);
+                    }
+                    slots_[slot] = count + 1;
+                    ++count;
+                }
+            }
+            if (count < threshold)
+            {
+                slots_.clear();
+            }
+            return count;
+        }
+    private:
+        template <class StringView>
+        static std::size_t hash_key(const StringView& key) noexcept
+        {
+            using uchar_type = typename std::make_unsigned<typename StringView::value_type>::type;
+
+            // FNV-1a, with the offset basis perturbed by a per-process seed
+            uint64_t h = 14695981039346656037ULL ^ jsoncons::detail::object_index_seed();
+            for (auto c : key)
+            {
+                h ^= static_cast<uint64_t>(static_cast<uchar_type>(c));
+                h *= 1099511628211ULL;
+            }
+            return static_cast<std::size_t>(jsoncons::detail::mix_hash_bits(h));
+        }
+
+        void allocate(std::size_t size)
+        {
+            std::size_t capacity = threshold;
+            while (capacity < 2*(size + 1))
+            {
+                capacity *= 2;
+            }
+            slots_.assign(capacity, 0);
+        }
+
+        void add(std::size_t hash, std::size_t pos)
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t slot = hash & mask;
+            while (slots_[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = pos + 1;
+        }
+    };
+
     // Sort keys
     template <class KeyT,class Json,template<typename,typename> class SequenceContainer = std::vector>
     class sorted_json_object : public allocator_holder<typename Json::allocator_type>    
@@ -956,6 +1227,301 @@ namespace jsoncons {
         }
     };
 
+    // Sort keys, and find the members of large objects with a hash index. The base is private 
+    // so that members cannot be added or removed without updating the index.
+    template <class KeyT,class Json,template<typename,typename> class SequenceContainer = std::vector>
+    class indexed_sorted_json_object : private sorted_json_object<KeyT,Json,SequenceContainer>
+    {
+        using base_type = sorted_json_object<KeyT,Json,SequenceContainer>;
+    public:
+        using allocator_type = typename base_type::allocator_type;
+        using key_type = typename base_type::key_type;
+        using key_value_type = typename base_type::key_value_type;
+        using char_type = typename base_type::char_type;
+        using string_view_type = typename base_type::string_view_type;
+        using iterator = typename base_type::iterator;
+        using const_iterator = typename base_type::const_iterator;
+    private:
+        typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t> index_allocator_type;
+        using index_container_type = SequenceContainer<std::size_t,index_allocator_type>;
+
+        // Empty for small objects, which are searched with a binary search
+        json_object_index<index_container_type> index_;
+    public:
+        using base_type::get_allocator;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::empty;
+        using base_type::size;
+        using base_type::capacity;
+        using base_type::reserve;
+        using base_type::at;
+
+        indexed_sorted_json_object()
+        {
+        }
+
+        explicit indexed_sorted_json_object(const allocator_type& alloc)
+            : base_type(alloc), 
+              index_(index_allocator_type(alloc))
+        {
+        }
+
+        indexed_sorted_json_object(const indexed_sorted_json_object& val)
+            : base_type(val),
+              index_(val.index_)
+        {
+        }
+
+        indexed_sorted_json_object(indexed_sorted_json_object&& val)
+            : base_type(std::move(val)), 
+              index_(std::move(val.index_))
+        {
+        }
+
+        indexed_sorted_json_object(const indexed_sorted_json_object& val, const allocator_type& alloc) 
+            : base_type(val, alloc), 
+              index_(val.index_,index_allocator_type(alloc))
+        {
+        }
+
+        indexed_sorted_json_object(indexed_sorted_json_object&& val,const allocator_type& alloc) 
+            : base_type(std::move(val), alloc), 
+              index_(std::move(val.index_),index_allocator_type(alloc))
+        {
+        }
+
+        template<class InputIt>
+        indexed_sorted_json_object(InputIt first, InputIt last)
+            : base_type(first, last)
+        {
+            build_index();
+        }
+
+        template<class InputIt>
+        indexed_sorted_json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : base_type(first, last, alloc), 
+              index_(index_allocator_type(alloc))
+        {
+            build_index();
+        }
+
+        indexed_sorted_json_object(const std::initializer_list<std::pair<std::basic_string<char_type>,Json>>& init, 
+                    const allocator_type& alloc = allocator_type())
+            : base_type(init, alloc), 
+              index_(index_allocator_type(alloc))
+        {
+            build_index();
+        }
+
+        indexed_sorted_json_object& operator=(const indexed_sorted_json_object& val)
+        {
+            base_type::operator=(val);
+            index_ = val.index_;
+            return *this;
+        }
+
+        indexed_sorted_json_object& operator=(indexed_sorted_json_object&& val)
+        {
+            val.swap(*this);
+            return *this;
+        }
+
+        void swap(indexed_sorted_json_object& val) noexcept
+        {
+            base_type::swap(val);
+            index_.swap(val.index_);
+        }
+
+        void clear() 
+        {
+            base_type::clear();
+            index_.clear();
+        }
+
+        void shrink_to_fit() 
+        {
+            base_type::shrink_to_fit();
+            index_.shrink_to_fit();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            if (index_.empty())
+            {
+                return base_type::find(name);
+            }
+            return begin() + index_.find(begin(), size(), name);
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            if (index_.empty())
+            {
+                return base_type::find(name);
+            }
+            return begin() + index_.find(begin(), size(), name);
+        }
+
+        iterator erase(const_iterator pos) 
+        {
+            if (pos != end())
+            {
+                std::size_t pos1 = pos - begin();
+                index_.erase(begin(), size(), pos1, pos1 + 1);
+            }
+            return base_type::erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) 
+        {
+            std::size_t pos1 = first - begin();
+            std::size_t pos2 = last - begin();
+            if (pos1 < size() && pos2 <= size())
+            {
+                index_.erase(begin(), size(), pos1, pos2);
+            }
+            return base_type::erase(first, last);
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            auto it = find(name);
+            if (it != end())
+            {
+                erase(it);
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            base_type::insert(first, last, convert);
+            build_index();
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag tag, InputIt first, InputIt last, Convert convert)
+        {
+            base_type::insert(tag, first, last, convert);
+            build_index();
+        }
+
+        template <class T>
+        std::pair<iterator,bool> insert_or_assign(const string_view_type& name, T&& value)
+        {
+            auto result = base_type::insert_or_assign(name, std::forward<T>(value));
+            if (result.second)
+            {
+                index_.insert(begin(), size(), result.first - begin());
+            }
+            return result;
+        }
+
+        template <class T>
+        iterator insert_or_assign(iterator hint, const string_view_type& name, T&& value)
+        {
+            std::size_t old_size = size();
+            auto it = base_type::insert_or_assign(hint, name, std::forward<T>(value));
+            if (size() != old_size)
+            {
+                index_.insert(begin(), size(), it - begin());
+            }
+            return it;
+        }
+
+        template <class... Args>
+        std::pair<iterator,bool> try_emplace(const string_view_type& name, Args&&... args)
+        {
+            auto result = base_type::try_emplace(name, std::forward<Args>(args)...);
+            if (result.second)
+            {
+                index_.insert(begin(), size(), result.first - begin());
+            }
+            return result;
+        }
+
+        template <class... Args>
+        iterator try_emplace(iterator hint, const string_view_type& name, Args&&... args)
+        {
+            std::size_t old_size = size();
+            auto it = base_type::try_emplace(hint, name, std::forward<Args>(args)...);
+            if (size() != old_size)
+            {
+                index_.insert(begin(), size(), it - begin());
+            }
+            return it;
+        }
+
+        // merge, after which the index is rebuilt once
+
+        void merge(const indexed_sorted_json_object& source)
+        {
+            base_type::merge(source);
+            build_index();
+        }
+
+        void merge(indexed_sorted_json_object&& source)
+        {
+            base_type::merge(std::move(source));
+            build_index();
+        }
+
+        void merge(iterator hint, const indexed_sorted_json_object& source)
+        {
+            base_type::merge(hint, source);
+            build_index();
+        }
+
+        void merge(iterator hint, indexed_sorted_json_object&& source)
+        {
+            base_type::merge(hint, std::move(source));
+            build_index();
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const indexed_sorted_json_object& source)
+        {
+            base_type::merge_or_update(source);
+            build_index();
+        }
+
+        void merge_or_update(indexed_sorted_json_object&& source)
+        {
+            base_type::merge_or_update(std::move(source));
+            build_index();
+        }
+
+        void merge_or_update(iterator hint, const indexed_sorted_json_object& source)
+        {
+            base_type::merge_or_update(hint, source);
+            build_index();
+        }
+
+        void merge_or_update(iterator hint, indexed_sorted_json_object&& source)
+        {
+            base_type::merge_or_update(hint, std::move(source));
+            build_index();
+        }
+
+        bool operator==(const indexed_sorted_json_object& rhs) const
+        {
+            return base_type::operator==(rhs);
+        }
+
+        bool operator<(const indexed_sorted_json_object& rhs) const
+        {
+            return base_type::operator<(rhs);
+        }
+    private:
+        void build_index()
+        {
+            index_.build(begin(), size());
+        }
+    };
+
     // Preserve order
     template <class KeyT,class Json,template<typename,typename> class SequenceContainer = std::vector>
     class order_preserving_json_object : public allocator_holder<typename Json::allocator_type>
@@ -977,20 +1543,8 @@ namespace jsoncons {
         using index_container_type = SequenceContainer<std::size_t,index_allocator_type>;
 
         key_value_container_type members_;
-        index_container_type index_;
-
-        struct Comp
-        {
-            const key_value_container_type& members_;
-
-            Comp(const key_value_container_type& members_)
-                : members_(members_)
-            {
-            }
-
-            bool operator() (std::size_t i, string_view_type k) const { return members_.at(i).key() < k; }
-            bool operator() (string_view_type k, std::size_t i) const { return k < members_.at(i).key(); }
-        };
+        // Empty for small objects, which are searched linearly
+        json_object_index<index_container_type> index_;
     public:
         using iterator = typename key_value_container_type::iterator;
         using const_iterator = typename key_value_container_type::const_iterator;
@@ -1045,29 +1599,7 @@ namespace jsoncons {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
 
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            remove_duplicates();
         }
 
         template<class InputIt>
@@ -1084,29 +1616,7 @@ namespace jsoncons {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
 
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            remove_duplicates();
         }
 
         order_preserving_json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
@@ -1144,6 +1654,7 @@ namespace jsoncons {
         void swap(order_preserving_json_object& val) noexcept
         {
             members_.swap(val.members_);
+            index_.swap(val.index_);
         }
 
         bool empty() const
@@ -1213,16 +1724,12 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
-            auto p = std::equal_range(index_.begin(),index_.end(), name, 
-                                        Comp(members_));        
-            return p.first == p.second ? members_.end() : members_.begin() + *p.first;
+            return members_.begin() + find_position(name);
         }
 
         const_iterator find(const string_view_type& name) const noexcept
         {
-            auto p = std::equal_range(index_.begin(),index_.end(), name, 
-                                        Comp(members_));        
-            return p.first == p.second ? members_.end() : members_.begin() + *p.first;
+            return members_.begin() + find_position(name);
         }
 
         iterator erase(const_iterator pos) 
@@ -1232,7 +1739,7 @@ namespace jsoncons {
                 std::size_t pos1 = pos - members_.begin();
                 std::size_t pos2 = pos1 + 1;
 
-                erase_index_entries(pos1, pos2);
+                index_.erase(members_.begin(), members_.size(), pos1, pos2);
     #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
                 iterator it = members_.begin() + (pos - members_.begin());
                 return members_.erase(it);
@@ -1253,7 +1760,7 @@ namespace jsoncons {
 
             if (pos1 < members_.size() && pos2 <= members_.size())
             {
-                erase_index_entries(pos1,pos2);
+                index_.erase(members_.begin(), members_.size(), pos1, pos2);
 
     #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
                 iterator it1 = members_.begin() + (first - members_.begin());
@@ -1277,7 +1784,7 @@ namespace jsoncons {
                 std::size_t pos1 = pos - members_.begin();
                 std::size_t pos2 = pos1 + 1;
 
-                erase_index_entries(pos1, pos2);
+                index_.erase(members_.begin(), members_.size(), pos1, pos2);
     #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
                 iterator it = members_.begin() + (pos - members_.begin());
                 members_.erase(it);
@@ -1297,29 +1804,7 @@ namespace jsoncons {
                 members_.emplace_back(convert(*s));
             }
 
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            remove_duplicates();
         }
 
         template<class InputIt, class Convert>
@@ -1333,23 +1818,24 @@ namespace jsoncons {
                 members_.emplace_back(convert(*s));
             }
 
-            build_index();
+            index_.build(members_.begin(), members_.size());
         }
 
         template <class T, class A=allocator_type>
         typename std::enable_if<type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_position(name);
+            if (pos == members_.size())
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
-                auto it = members_.begin() + result.first;
+                index_.insert(members_.begin(), members_.size(), pos);
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value)));
                 return std::make_pair(it,false);
             }
@@ -1359,17 +1845,18 @@ namespace jsoncons {
         typename std::enable_if<!type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_position(name);
+            if (pos == members_.size())
             {
                 members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
                                       std::forward<T>(value),get_allocator());
-                auto it = members_.begin() + result.first;
+                index_.insert(members_.begin(), members_.size(), pos);
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value),get_allocator()));
                 return std::make_pair(it,false);
             }
@@ -1387,16 +1874,17 @@ namespace jsoncons {
             else
             {
                 std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
+                std::size_t found = find_position(key);
 
-                if (result.second)
+                if (found == members_.size())
                 {
                     auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<T>(value));
+                    index_.insert(members_.begin(), members_.size(), pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + found;
                     it->value(Json(std::forward<T>(value)));
                     return it;
                 }
@@ -1415,18 +1903,19 @@ namespace jsoncons {
             else
             {
                 std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
+                std::size_t found = find_position(key);
 
-                if (result.second)
+                if (found == members_.size())
                 {
                     auto it = members_.emplace(hint, 
                                                key_type(key.begin(),key.end(),get_allocator()), 
                                                std::forward<T>(value),get_allocator());
+                    index_.insert(members_.begin(), members_.size(), pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + found;
                     it->value(Json(std::forward<T>(value),get_allocator()));
                     return it;
                 }
@@ -1572,16 +2061,17 @@ namespace jsoncons {
         typename std::enable_if<type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& name, Args&&... args)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_position(name);
+            if (pos == members_.size())
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
+                index_.insert(members_.begin(), members_.size(), pos);
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,false);
             }
         }
@@ -1590,17 +2080,18 @@ namespace jsoncons {
         typename std::enable_if<!type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& key, Args&&... args)
         {
-            auto result = insert_index_entry(key,members_.size());
-            if (result.second)
+            std::size_t pos = find_position(key);
+            if (pos == members_.size())
             {
                 members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                                       std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
+                index_.insert(members_.begin(), members_.size(), pos);
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 return std::make_pair(it,false);
             }
         }
@@ -1617,16 +2108,17 @@ namespace jsoncons {
             else
             {
                 std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
+                std::size_t found = find_position(key);
 
-                if (result.second)
+                if (found == members_.size())
                 {
                     auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
+                    index_.insert(members_.begin(), members_.size(), pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + found;
                     return it;
                 }
             }
@@ -1644,18 +2136,19 @@ namespace jsoncons {
             else
             {
                 std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
+                std::size_t found = find_position(key);
 
-                if (result.second)
+                if (found == members_.size())
                 {
                     auto it = members_.emplace(hint, 
                                                key_type(key.begin(),key.end(), get_allocator()), 
                                                std::forward<Args>(args)...);
+                    index_.insert(members_.begin(), members_.size(), pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + found;
                     return it;
                 }
             }
@@ -1688,82 +2181,28 @@ namespace jsoncons {
             }
         }
 
-        std::pair<std::size_t,bool> insert_index_entry(const string_view_type& key, std::size_t pos)
+        // Returns the position of the member with this key, or members_.size() if there is none
+        std::size_t find_position(const string_view_type& key) const noexcept
         {
-            JSONCONS_ASSERT(pos <= index_.size());
-
-            auto it = std::lower_bound(index_.begin(),index_.end(), key, 
-                                        Comp(members_));        
-
-            if (it == index_.end())
-            {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
-                {
-                    if (index_[i] >= pos)
-                    {
-                        ++index_[i];
-                        --count;
-                    }
-                }
-                index_.push_back(pos);
-                return std::make_pair(pos,true);
-            }
-            else if (members_.at(*it).key() != key)
+            if (index_.empty())
             {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
+                for (std::size_t i = 0; i < members_.size(); ++i)
                 {
-                    if (index_[i] >= pos)
+                    if (members_[i].key() == key)
                     {
-                        ++index_[i];
-                        --count;
+                        return i;
                     }
                 }
-                auto it2 = index_.insert(it, pos);
-                return std::make_pair(*it2,true);
-            }
-            else
-            {
-                return std::make_pair(*it,false);
-            }
-        }
-
-        void erase_index_entries(std::size_t pos1, std::size_t pos2)
-        {
-            JSONCONS_ASSERT(pos1 <= pos2);
-            JSONCONS_ASSERT(pos2 <= index_.size());
-
-            const size_t offset = pos2 - pos1;
-            const size_t n = index_.size() - offset;
-            for (std::size_t i = 0; i < index_.size(); ++i)
-            {
-                if (index_[i] >= pos1 && index_[i] < pos2)
-                {
-                    index_.erase(index_.begin()+i);
-                    --i;
-                }
-            }
-            for (std::size_t i = 0; i < index_.size(); ++i)
-            {
-                if (index_[i] >= pos2)
-                {
-                    index_[i] -= offset;
-                }
+                return members_.size();
             }
-            JSONCONS_ASSERT(index_.size() == n);
+            return index_.find(members_.begin(), members_.size(), key);
         }
 
-        void build_index()
+        // Keeps the first member with each key, preserving order
+        void remove_duplicates()
         {
-            index_.clear();
-            index_.reserve(members_.size());
-            for (std::size_t i = 0; i < members_.size(); ++i)
-            {
-                index_.push_back(i);
-            }
-            std::stable_sort(index_.begin(),index_.end(),
-                             [&](std::size_t a, std::size_t b) -> bool {return members_.at(a).key().compare(members_.at(b).key()) < 0;});
+            std::size_t count = index_.remove_duplicates(members_.begin(), members_.size());
+            members_.erase(members_.begin() + count, members_.end());
         }
     };
 
@@ -15,7 +15,7 @@
 
 namespace jsoncons {
 
-enum class float_chars_format : uint8_t {general,fixed,scientific,hex};
+enum class float_chars_format : uint8_t {general,fixed,scientific,hex,shortest};
 
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use float_chars_format") typedef float_chars_format chars_format;
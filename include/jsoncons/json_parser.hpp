@@ -21,6 +21,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/string_scan.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -154,6 +155,7 @@ private:
     json_parse_state state_;
     bool more_;
     bool done_;
+    bool string_needs_validation_;
 
     std::basic_string<char_type,std::char_traits<char_type>,char_allocator_type> string_buffer_;
     jsoncons::detail::chars_to to_double_;
@@ -202,6 +204,7 @@ public:
          state_(json_parse_state::start),
          more_(true),
          done_(false),
+         string_needs_validation_(false),
          string_buffer_(alloc),
          state_stack_(alloc)
     {
@@ -489,6 +492,7 @@ public:
         state_ = json_parse_state::start;
         more_ = true;
         done_ = false;
+        string_needs_validation_ = false;
         line_ = 1;
         position_ = 0;
         mark_position_ = 0;
@@ -2176,6 +2180,11 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = skip_string_chars(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
@@ -2332,6 +2341,7 @@ escape:
             goto string_u1;
         case 'u':
              cp_ = 0;
+             string_needs_validation_ = true;
              ++input_ptr_;
              ++position_;
              goto escape_u1;
@@ -2722,12 +2732,16 @@ private:
     void end_string_value(const char_type* s, std::size_t length, basic_json_visitor<char_type>& visitor, std::error_code& ec) 
     {
         string_view_type sv(s, length);
-        auto result = unicode_traits::validate(s, length);
-        if (result.ec != unicode_traits::conv_errc())
+        if (string_needs_validation_)
         {
-            translate_conv_errc(result.ec,ec);
-            position_ += (result.ptr - s);
-            return;
+            string_needs_validation_ = false;
+            auto result = unicode_traits::validate(s, length);
+            if (result.ec != unicode_traits::conv_errc())
+            {
+                translate_conv_errc(result.ec,ec);
+                position_ += (result.ptr - s);
+                return;
+            }
         }
         switch (parent())
         {
@@ -2821,6 +2835,26 @@ private:
         }
     }
 
+    // Advances over characters that need no special handling inside a string, and 
+    // notes whether the string will need UTF-8 validation
+
+    const char_type* skip_string_chars(const char_type* first, const char_type* last)
+    {
+        return skip_string_chars(first, last, std::integral_constant<bool,sizeof(char_type) == sizeof(char)>());
+    }
+
+    const char_type* skip_string_chars(const char_type* first, const char_type* last, std::true_type)
+    {
+        const char* p = reinterpret_cast<const char*>(first);
+        return first + (jsoncons::detail::skip_string_chars(p, p + (last - first), string_needs_validation_) - p);
+    }
+
+    const char_type* skip_string_chars(const char_type* first, const char_type*, std::false_type)
+    {
+        string_needs_validation_ = true;
+        return first;
+    }
+
     void push_state(json_parse_state state)
     {
         state_stack_.push_back(state);
@@ -110,7 +110,8 @@ namespace jsoncons {
         array_value = 0x09,
         empty_object_value = 0x0a,
         object_value = 0x0b,
-        json_const_pointer = 0x0c
+        json_const_pointer = 0x0c,
+        string_view_value = 0x0d
     };
 
     template <class CharT>
@@ -129,6 +130,7 @@ namespace jsoncons {
         static constexpr const CharT* empty_object_value = JSONCONS_CSTRING_CONSTANT(CharT, "empty_object");
         static constexpr const CharT* object_value = JSONCONS_CSTRING_CONSTANT(CharT, "object");
         static constexpr const CharT* json_const_pointer = JSONCONS_CSTRING_CONSTANT(CharT, "json_const_pointer");
+        static constexpr const CharT* string_view_value = JSONCONS_CSTRING_CONSTANT(CharT, "string_view");
 
         switch (storage)
         {
@@ -197,6 +199,11 @@ namespace jsoncons {
                 os << json_const_pointer;
                 break;
             }
+            case json_storage_kind::string_view_value:
+            {
+                os << string_view_value;
+                break;
+            }
         }
         return os;
     }
@@ -0,0 +1,286 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <string>
+#include <limits> // std::numeric_limits
+#include <cstring> // std::memcpy
+#include <utility> // std::move, std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // A read only mapping of a whole file, with the system told that it will be read sequentially
+    class file_mapping
+    {
+        const void* data_;
+        std::size_t size_;
+        bool is_error_;
+
+        // Noncopyable
+        file_mapping(const file_mapping&) = delete;
+        file_mapping& operator=(const file_mapping&) = delete;
+    public:
+        file_mapping() noexcept
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+        }
+
+        explicit file_mapping(const char* path) noexcept
+            : data_(nullptr), size_(0), is_error_(true)
+        {
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                return;
+            }
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(file, &size) && static_cast<unsigned long long>(size.QuadPart) <= (std::numeric_limits<std::size_t>::max)())
+            {
+                size_ = static_cast<std::size_t>(size.QuadPart);
+                if (size_ == 0)
+                {
+                    is_error_ = false;
+                }
+                else
+                {
+                    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping != nullptr)
+                    {
+                        data_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                        is_error_ = data_ == nullptr;
+                        ::CloseHandle(mapping);
+                    }
+                }
+            }
+            ::CloseHandle(file);
+#else
+            int fd = ::open(path, O_RDONLY);
+            if (fd == -1)
+            {
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+            {
+                size_ = static_cast<std::size_t>(st.st_size);
+                if (size_ == 0)
+                {
+                    is_error_ = false;
+                }
+                else
+                {
+                    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED)
+                    {
+                        ::madvise(p, size_, MADV_SEQUENTIAL);
+                        data_ = p;
+                        is_error_ = false;
+                    }
+                }
+            }
+            ::close(fd);
+#endif
+            if (is_error_)
+            {
+                size_ = 0;
+            }
+        }
+
+        file_mapping(file_mapping&& other) noexcept
+            : data_(other.data_), size_(other.size_), is_error_(other.is_error_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        file_mapping& operator=(file_mapping&& other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(is_error_, other.is_error_);
+            return *this;
+        }
+
+        ~file_mapping() noexcept
+        {
+            if (data_ != nullptr)
+            {
+#if defined(_WIN32)
+                ::UnmapViewOfFile(data_);
+#else
+                ::munmap(const_cast<void*>(data_), size_);
+#endif
+            }
+        }
+
+        const void* data() const noexcept
+        {
+            return data_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool is_error() const noexcept
+        {
+            return is_error_;
+        }
+    };
+
+} // namespace detail
+
+    // mmap_source
+
+    template <class CharT>
+    class mmap_source
+    {
+    public:
+        using value_type = CharT;
+    private:
+        detail::file_mapping mapping_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit mmap_source(const char* path)
+            : mapping_(path),
+              data_(static_cast<const value_type*>(mapping_.data())),
+              current_(data_),
+              end_(data_ + mapping_.size()/sizeof(value_type))
+        {
+        }
+
+        explicit mmap_source(const std::string& path)
+            : mmap_source(path.c_str())
+        {
+        }
+
+        mmap_source(mmap_source&& other) noexcept
+            : mapping_(std::move(other.mapping_)),
+              data_(other.data_), current_(other.current_), end_(other.end_)
+        {
+            other.data_ = other.current_ = other.end_ = nullptr;
+        }
+
+        mmap_source& operator=(mmap_source&& other) noexcept
+        {
+            mapping_ = std::move(other.mapping_);
+            std::swap(data_, other.data_);
+            std::swap(current_, other.current_);
+            std::swap(end_, other.end_);
+            return *this;
+        }
+
+        // The whole file, which stays mapped for the lifetime of the source
+        const value_type* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return end_ - data_;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return mapping_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return current_ - data_;
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < count)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = count;
+            }
+            current_ += len;
+        }
+
+        char_result<value_type> peek()
+        {
+            return current_ < end_ ? char_result<value_type>{*current_, false} : char_result<value_type>{0, true};
+        }
+
+        span<const value_type> read_buffer()
+        {
+            const value_type* data = current_;
+            std::size_t length = end_ - current_;
+            current_ = end_;
+
+            return span<const value_type>(data, length);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < length)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_  += len;
+            return len;
+        }
+    };
+
+    using binary_mmap_source = mmap_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,246 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_REGEX_ENGINE_HPP
+#define JSONCONS_REGEX_ENGINE_HPP
+
+#include <cstddef>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <regex>
+#include <string>
+#include <type_traits> // std::is_same
+#include <utility> // std::move
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/lru_cache.hpp>
+#include <jsoncons/detail/regex_dfa.hpp>
+
+namespace jsoncons {
+
+    // A compiled ECMAScript regular expression. Implementations must be safe to
+    // search from several threads at once.
+    template <class CharT>
+    class basic_regex_pattern
+    {
+    public:
+        virtual ~basic_regex_pattern() = default;
+
+        // Whether the pattern matches some part of [data, data+length)
+        virtual bool search(const CharT* data, std::size_t length) const = 0;
+
+        bool search(const std::basic_string<CharT>& s) const
+        {
+            return search(s.data(), s.size());
+        }
+    };
+
+    // Compiles ECMAScript regular expressions for JSONPath filters and JSON Schema
+    // "pattern", "patternProperties" and "format": "regex".
+    template <class CharT>
+    class basic_regex_engine
+    {
+    public:
+        using pattern_pointer = std::shared_ptr<const basic_regex_pattern<CharT>>;
+
+        virtual ~basic_regex_engine() = default;
+
+        // Throws std::regex_error if pattern is not a valid regular expression
+        virtual pattern_pointer compile(const std::basic_string<CharT>& pattern, bool icase) const = 0;
+    };
+
+#if defined(JSONCONS_HAS_STD_REGEX)
+
+    // Compiles to std::basic_regex
+    template <class CharT>
+    class std_regex_engine : public basic_regex_engine<CharT>
+    {
+        class std_regex_pattern : public basic_regex_pattern<CharT>
+        {
+            std::basic_regex<CharT> regex_;
+        public:
+            std_regex_pattern(const std::basic_string<CharT>& pattern, bool icase)
+                : regex_(pattern, icase ? std::regex_constants::ECMAScript | std::regex_constants::icase : std::regex_constants::ECMAScript)
+            {
+            }
+
+            bool search(const CharT* data, std::size_t length) const override
+            {
+                return std::regex_search(data, data + length, regex_);
+            }
+        };
+    public:
+        using typename basic_regex_engine<CharT>::pattern_pointer;
+
+        pattern_pointer compile(const std::basic_string<CharT>& pattern, bool icase) const override
+        {
+            return std::make_shared<std_regex_pattern>(pattern, icase);
+        }
+    };
+
+#endif
+
+    // Compiles char patterns in the common subset of ECMAScript to a deterministic
+    // automaton, which searches in time linear in the length of the input, and the rest
+    // to std::basic_regex
+    template <class CharT>
+    class default_regex_engine : public basic_regex_engine<CharT>
+    {
+        class dfa_pattern : public basic_regex_pattern<CharT>
+        {
+            jsoncons::detail::regex_dfa dfa_;
+        public:
+            dfa_pattern(jsoncons::detail::regex_dfa&& dfa)
+                : dfa_(std::move(dfa))
+            {
+            }
+
+            bool search(const CharT* data, std::size_t length) const override
+            {
+                return dfa_.search(data, length);
+            }
+        };
+    public:
+        using typename basic_regex_engine<CharT>::pattern_pointer;
+
+        pattern_pointer compile(const std::basic_string<CharT>& pattern, bool icase) const override
+        {
+            pattern_pointer p = compile_dfa(pattern, icase, std::is_same<CharT,char>());
+            if (p)
+            {
+                return p;
+            }
+#if defined(JSONCONS_HAS_STD_REGEX)
+            return std_regex_engine<CharT>().compile(pattern, icase);
+#else
+            JSONCONS_THROW(std::regex_error(std::regex_constants::error_complexity));
+#endif
+        }
+    private:
+        static pattern_pointer compile_dfa(const std::basic_string<CharT>& pattern, bool icase, std::true_type)
+        {
+            jsoncons::detail::regex_dfa dfa;
+            if (!dfa.compile(pattern.data(), pattern.size(), icase))
+            {
+                return pattern_pointer();
+            }
+            return std::make_shared<dfa_pattern>(std::move(dfa));
+        }
+
+        static pattern_pointer compile_dfa(const std::basic_string<CharT>&, bool, std::false_type)
+        {
+            return pattern_pointer();
+        }
+    };
+
+    using regex_pattern = basic_regex_pattern<char>;
+    using wregex_pattern = basic_regex_pattern<wchar_t>;
+    using regex_engine = basic_regex_engine<char>;
+    using wregex_engine = basic_regex_engine<wchar_t>;
+
+namespace detail {
+
+    // The engine in use, and the patterns it compiled, for one character type
+    template <class CharT>
+    class regex_registry
+    {
+        using string_type = std::basic_string<CharT>;
+        using engine_pointer = std::shared_ptr<const basic_regex_engine<CharT>>;
+
+        std::mutex mutex_;
+        engine_pointer engine_;
+        lru_cache<string_type,basic_regex_pattern<CharT>> cache_;
+        lru_cache<string_type,basic_regex_pattern<CharT>> icase_cache_;
+    public:
+        static constexpr std::size_t cache_capacity = 1024;
+
+        regex_registry()
+            : engine_(std::make_shared<default_regex_engine<CharT>>()),
+              cache_(cache_capacity), icase_cache_(cache_capacity)
+        {
+        }
+
+        static regex_registry& instance()
+        {
+            static regex_registry registry;
+            return registry;
+        }
+
+        engine_pointer engine()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return engine_;
+        }
+
+        void engine(engine_pointer engine)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                engine_ = engine ? std::move(engine) : std::make_shared<default_regex_engine<CharT>>();
+            }
+            cache_.clear();
+            icase_cache_.clear();
+        }
+
+        std::shared_ptr<const basic_regex_pattern<CharT>> compile(const string_type& pattern, bool icase)
+        {
+            auto& cache = icase ? icase_cache_ : cache_;
+            return cache.get_or_create(pattern, [&]() {return engine()->compile(pattern, icase);});
+        }
+
+        cache_stats stats() const
+        {
+            cache_stats s = cache_.stats();
+            cache_stats t = icase_cache_.stats();
+            return cache_stats{s.hits + t.hits, s.misses + t.misses, s.evictions + t.evictions,
+                               s.size + t.size, s.capacity + t.capacity};
+        }
+    };
+
+    template <class CharT>
+    constexpr std::size_t regex_registry<CharT>::cache_capacity;
+
+#if defined(JSONCONS_HAS_STD_REGEX)
+
+    // A cached std::basic_regex, for uses that need more than search, such as splitting
+    template <class CharT>
+    std::shared_ptr<const std::basic_regex<CharT>> cached_std_regex(const std::basic_string<CharT>& pattern)
+    {
+        static lru_cache<std::basic_string<CharT>,std::basic_regex<CharT>> cache(regex_registry<CharT>::cache_capacity);
+        return cache.get_or_create(pattern, 
+            [&]() {return std::make_shared<std::basic_regex<CharT>>(pattern, std::regex_constants::ECMAScript);});
+    }
+
+#endif
+
+} // namespace detail
+
+    // Replaces the engine used for all patterns of this character type, and empties
+    // the pattern cache. A null engine restores the default_regex_engine.
+    template <class CharT>
+    void set_regex_engine(std::shared_ptr<const basic_regex_engine<CharT>> engine)
+    {
+        detail::regex_registry<CharT>::instance().engine(std::move(engine));
+    }
+
+    // Returns the compiled pattern, from a process wide cache of recently used patterns,
+    // or compiled by the current engine. Throws std::regex_error if pattern is not valid.
+    template <class CharT>
+    std::shared_ptr<const basic_regex_pattern<CharT>> compile_regex(const std::basic_string<CharT>& pattern,
+                                                                    bool icase = false)
+    {
+        return detail::regex_registry<CharT>::instance().compile(pattern, icase);
+    }
+
+    template <class CharT>
+    cache_stats regex_cache_stats()
+    {
+        return detail::regex_registry<CharT>::instance().stats();
+    }
+
+} // namespace jsoncons
+
+#endif
@@ -65,6 +65,13 @@ struct json_const_pointer_arg_t
 };
 
 constexpr json_const_pointer_arg_t json_const_pointer_arg{};
+
+struct string_view_arg_t
+{
+    explicit string_view_arg_t() = default; 
+};
+
+constexpr string_view_arg_t string_view_arg{};
  
 enum class semantic_tag : uint8_t 
 {
@@ -18,6 +18,8 @@
 #include <algorithm> // std::stable_sort, std::reverse
 #include <cmath> // std::abs
 #include <jsoncons/json.hpp>
+#include <jsoncons/detail/lru_cache.hpp>
+#include <jsoncons/detail/scratch_arena.hpp>
 #include <jsoncons_ext/jmespath/jmespath_error.hpp>
 
 namespace jsoncons { 
@@ -312,6 +314,9 @@ namespace jmespath {
         }
     };
 
+    template <class Json>
+    class evaluation_resources;
+
     namespace detail {
      
     enum class path_state 
@@ -382,11 +387,34 @@ namespace jmespath {
         using pointer = typename std::conditional<std::is_const<typename std::remove_reference<JsonReference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
         typedef typename Json::const_pointer const_pointer;
 
-        std::vector<std::unique_ptr<Json>> temp_storage_;
+        // temporaries live in the calling thread's scratch arena, which keeps its blocks
+        // between evaluations
+        jsoncons::detail::scratch_arena& arena_;
+        jsoncons::detail::scratch_arena::mark_type mark_;
 
     public:
-        ~dynamic_resources()
+        dynamic_resources()
+            : arena_(jsoncons::detail::scratch_arena::thread_instance()), mark_(arena_.mark())
+        {
+        }
+
+        explicit dynamic_resources(jsoncons::detail::scratch_arena& arena)
+            : arena_(arena), mark_(arena_.mark())
+        {
+        }
+
+        dynamic_resources(const dynamic_resources&) = delete;
+        dynamic_resources& operator=(const dynamic_resources&) = delete;
+
+        ~dynamic_resources() noexcept
         {
+            arena_.rewind(mark_);
+        }
+
+        // Destroys the temporaries made so far
+        void clear() noexcept
+        {
+            arena_.rewind(mark_);
         }
 
         reference number_type_name() 
@@ -452,10 +480,13 @@ namespace jmespath {
         template <typename... Args>
         Json* create_json(Args&& ... args)
         {
-            auto temp = jsoncons::make_unique<Json>(std::forward<Args>(args)...);
-            Json* ptr = temp.get();
-            temp_storage_.emplace_back(std::move(temp));
-            return ptr;
+            return arena_.template create<Json>(std::forward<Args>(args)...);
+        }
+
+        // Number of temporaries made by this evaluation so far
+        std::size_t temp_count() const
+        {
+            return arena_.object_count() - mark_.object_count;
         }
     };
 
@@ -596,6 +627,12 @@ namespace jmespath {
 
             virtual void add_expression(std::unique_ptr<expression_base>&& expressions) = 0;
 
+            // The member name, if this expression selects a member by name
+            virtual const string_type* identifier() const
+            {
+                return nullptr;
+            }
+
             virtual std::string to_string(std::size_t = 0) const
             {
                 return std::string("to_string not implemented");
@@ -702,7 +739,7 @@ namespace jmespath {
 
             virtual ~function_base() = default;
 
-            virtual reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>&, std::error_code& ec) const = 0;
+            virtual reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>&, std::error_code& ec) const = 0;
 
             virtual std::string to_string(std::size_t = 0) const
             {
@@ -718,7 +755,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -758,7 +795,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -802,7 +839,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -839,7 +876,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -892,7 +929,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -938,7 +975,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -975,7 +1012,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1027,7 +1064,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1067,7 +1104,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1122,7 +1159,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1184,7 +1221,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1232,7 +1269,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1287,7 +1324,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1349,7 +1386,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 if (args.empty())
                 {
@@ -1404,7 +1441,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1446,7 +1483,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1498,7 +1535,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1559,7 +1596,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1595,7 +1632,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1631,7 +1668,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1675,7 +1712,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1721,7 +1758,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1760,7 +1797,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1797,7 +1834,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1860,7 +1897,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
                 JSONCONS_ASSERT(args.size() == *this->arity());
 
@@ -1888,7 +1925,7 @@ namespace jmespath {
             {
             }
 
-            reference evaluate(std::vector<parameter>& args, dynamic_resources<Json,JsonReference>& resources, std::error_code&) const override
+            reference evaluate(jsoncons::span<const parameter> args, dynamic_resources<Json,JsonReference>& resources, std::error_code&) const override
             {
                 for (auto& param : args)
                 {
@@ -2276,100 +2313,214 @@ namespace jmespath {
             }
         };
 
-        static pointer evaluate_tokens(reference doc, const std::vector<token>& output_stack, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec)
+        static reference select_identifier(reference val, const string_type& identifier, dynamic_resources<Json,JsonReference>& resources)
         {
-            pointer root_ptr = std::addressof(doc);
-            std::vector<parameter> stack;
-            std::vector<parameter> arg_stack;
-            for (std::size_t i = 0; i < output_stack.size(); ++i)
+            if (val.is_object())
             {
-                auto& t = output_stack[i];
-                switch (t.type())
+                auto it = val.find(identifier);
+                if (it != val.object_range().end())
                 {
-                    case token_kind::literal:
-                    {
-                        stack.emplace_back(t.value_);
-                        break;
-                    }
-                    case token_kind::begin_expression_type:
-                    {
-                        JSONCONS_ASSERT(i+1 < output_stack.size());
-                        ++i;
-                        JSONCONS_ASSERT(output_stack[i].is_expression());
-                        JSONCONS_ASSERT(!stack.empty());
-                        stack.pop_back();
-                        stack.emplace_back(output_stack[i].expression_.get());
-                        break;
-                    }
-                    case token_kind::pipe:
-                    {
-                        JSONCONS_ASSERT(!stack.empty());
-                        root_ptr = std::addressof(stack.back().value());
-                        break;
-                    }
-                    case token_kind::current_node:
-                        stack.emplace_back(*root_ptr);
-                        break;
-                    case token_kind::expression:
-                    {
-                        JSONCONS_ASSERT(!stack.empty());
-                        pointer ptr = std::addressof(stack.back().value());
-                        stack.pop_back();
-                        auto& ref = t.expression_->evaluate(*ptr, resources, ec);
-                        stack.emplace_back(ref);
-                        break;
-                    }
-                    case token_kind::unary_operator:
-                    {
-                        JSONCONS_ASSERT(stack.size() >= 1);
-                        pointer ptr = std::addressof(stack.back().value());
-                        stack.pop_back();
-                        reference r = t.unary_operator_->evaluate(*ptr, resources, ec);
-                        stack.emplace_back(r);
-                        break;
-                    }
-                    case token_kind::binary_operator:
+                    return it->value();
+                }
+            }
+            return resources.null_value();
+        }
+
+        // program
+
+        enum class opcode : uint8_t
+        {
+            literal,
+            current_node,
+            expression_type,
+            pipe,
+            identifier,
+            expression,
+            unary_operator,
+            binary_operator,
+            argument,
+            function
+        };
+
+        struct instruction
+        {
+            opcode op;
+            union
+            {
+                const Json* value;
+                expression_base* expression;
+                const string_type* identifier;
+                const unary_operator* unary;
+                const binary_operator* binary;
+                const function_base* function;
+            };
+
+            instruction(opcode op) noexcept
+                : op(op), value(nullptr)
+            {
+            }
+        };
+
+        // A token list compiled to instructions with resolved operands. The stack depth and
+        // the number of function arguments are known after compiling, so that running the
+        // program needs no allocation unless the depth exceeds inline_stack_size.
+        // The program refers into the tokens, which must outlive it.
+        class program
+        {
+            static constexpr std::size_t inline_stack_size = 16;
+            using storage_type = typename std::aligned_storage<sizeof(parameter), alignof(parameter)>::type;
+
+            std::vector<instruction> code_;
+            std::size_t stack_size_;
+            std::size_t arg_count_;
+        public:
+            program() noexcept
+                : stack_size_(0), arg_count_(0)
+            {
+            }
+
+            explicit program(const std::vector<token>& tokens)
+                : stack_size_(0), arg_count_(0)
+            {
+                code_.reserve(tokens.size());
+                std::size_t depth = 0;
+                for (std::size_t i = 0; i < tokens.size(); ++i)
+                {
+                    auto& t = tokens[i];
+                    switch (t.type())
                     {
-                        JSONCONS_ASSERT(stack.size() >= 2);
-                        pointer rhs = std::addressof(stack.back().value());
-                        stack.pop_back();
-                        pointer lhs = std::addressof(stack.back().value());
-                        stack.pop_back();
-                        reference r = t.binary_operator_->evaluate(*lhs,*rhs, resources, ec);
-                        stack.emplace_back(r);
-                        break;
+                        case token_kind::literal:
+                            code_.emplace_back(opcode::literal);
+                            code_.back().value = std::addressof(t.value_);
+                            ++depth;
+                            break;
+                        case token_kind::begin_expression_type:
+                            JSONCONS_ASSERT(i+1 < tokens.size());
+                            ++i;
+                            JSONCONS_ASSERT(tokens[i].is_expression());
+                            JSONCONS_ASSERT(depth >= 1);
+                            code_.emplace_back(opcode::expression_type);
+                            code_.back().expression = tokens[i].expression_.get();
+                            break;
+                        case token_kind::pipe:
+                            JSONCONS_ASSERT(depth >= 1);
+                            code_.emplace_back(opcode::pipe);
+                            break;
+                        case token_kind::current_node:
+                            code_.emplace_back(opcode::current_node);
+                            ++depth;
+                            break;
+                        case token_kind::expression:
+                            JSONCONS_ASSERT(depth >= 1);
+                            if (t.expression_->identifier() != nullptr)
+                            {
+                                code_.emplace_back(opcode::identifier);
+                                code_.back().identifier = t.expression_->identifier();
+                            }
+                            else
+                            {
+                                code_.emplace_back(opcode::expression);
+                                code_.back().expression = t.expression_.get();
+                            }
+                            break;
+                        case token_kind::unary_operator:
+                            JSONCONS_ASSERT(depth >= 1);
+                            code_.emplace_back(opcode::unary_operator);
+                            code_.back().unary = t.unary_operator_;
+                            break;
+                        case token_kind::binary_operator:
+                            JSONCONS_ASSERT(depth >= 2);
+                            code_.emplace_back(opcode::binary_operator);
+                            code_.back().binary = t.binary_operator_;
+                            --depth;
+                            break;
+                        case token_kind::argument:
+                            JSONCONS_ASSERT(depth >= 1);
+                            code_.emplace_back(opcode::argument);
+                            --depth;
+                            ++arg_count_;
+                            break;
+                        case token_kind::function:
+                            // the parser has rejected calls with the wrong number of arguments
+                            JSONCONS_ASSERT(!t.function_->arity() || *(t.function_->arity()) == arg_count_);
+                            code_.emplace_back(opcode::function);
+                            code_.back().function = t.function_;
+                            ++depth;
+                            break;
+                        default:
+                            break;
                     }
-                    case token_kind::argument:
+                    if (depth > stack_size_)
                     {
-                        JSONCONS_ASSERT(!stack.empty());
-                        arg_stack.push_back(std::move(stack.back()));
-                        stack.pop_back();
-                        break;
+                        stack_size_ = depth;
                     }
-                    case token_kind::function:
-                    {
-                        if (t.function_->arity() && *(t.function_->arity()) != arg_stack.size())
-                        {
-                            ec = jmespath_errc::invalid_arity;
-                            return std::addressof(resources.null_value());
-                        }
+                }
+            }
 
-                        reference r = t.function_->evaluate(arg_stack, resources, ec);
-                        if (ec)
+            pointer run(reference doc, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const
+            {
+                storage_type inline_stack[inline_stack_size];
+                std::unique_ptr<storage_type[]> heap_stack;
+                parameter* stack = reinterpret_cast<parameter*>(inline_stack);
+                if (stack_size_ + arg_count_ > inline_stack_size)
+                {
+                    heap_stack.reset(new storage_type[stack_size_ + arg_count_]);
+                    stack = reinterpret_cast<parameter*>(heap_stack.get());
+                }
+                parameter* args = stack + stack_size_;
+                std::size_t top = 0;
+                std::size_t arg_top = 0;
+
+                pointer root_ptr = std::addressof(doc);
+                for (auto& ins : code_)
+                {
+                    switch (ins.op)
+                    {
+                        case opcode::literal:
+                            ::new(stack + top++) parameter(*ins.value);
+                            break;
+                        case opcode::current_node:
+                            ::new(stack + top++) parameter(*root_ptr);
+                            break;
+                        case opcode::expression_type:
+                            stack[top-1] = parameter(ins.expression);
+                            break;
+                        case opcode::pipe:
+                            root_ptr = std::addressof(stack[top-1].value());
+                            break;
+                        case opcode::identifier:
+                            stack[top-1] = parameter(select_identifier(stack[top-1].value(), *ins.identifier, resources));
+                            break;
+                        case opcode::expression:
+                            stack[top-1] = parameter(ins.expression->evaluate(stack[top-1].value(), resources, ec));
+                            break;
+                        case opcode::unary_operator:
+                            stack[top-1] = parameter(ins.unary->evaluate(stack[top-1].value(), resources, ec));
+                            break;
+                        case opcode::binary_operator:
+                            --top;
+                            stack[top-1] = parameter(ins.binary->evaluate(stack[top-1].value(), stack[top].value(), resources, ec));
+                            break;
+                        case opcode::argument:
+                            ::new(args + arg_top++) parameter(stack[--top]);
+                            break;
+                        case opcode::function:
                         {
-                            return std::addressof(resources.null_value());
+                            reference r = ins.function->evaluate(jsoncons::span<const parameter>(args, arg_top), resources, ec);
+                            if (ec)
+                            {
+                                return std::addressof(resources.null_value());
+                            }
+                            arg_top = 0;
+                            ::new(stack + top++) parameter(r);
+                            break;
                         }
-                        arg_stack.clear();
-                        stack.emplace_back(r);
-                        break;
                     }
-                    default:
-                        break;
                 }
+                JSONCONS_ASSERT(top == 1);
+                return std::addressof(stack[0].value());
             }
-            JSONCONS_ASSERT(stack.size() == 1);
-            return std::addressof(stack.back().value());
-        }
+        };
 
         // Implementations
 
@@ -2633,15 +2784,12 @@ namespace jmespath {
 
             reference evaluate(reference val, dynamic_resources<Json,JsonReference>& resources, std::error_code&) const override
             {
-                //std::cout << "(identifier_selector " << identifier_  << " ) " << pretty_print(val) << "\n";
-                if (val.is_object() && val.contains(identifier_))
-                {
-                    return val.at(identifier_);
-                }
-                else 
-                {
-                    return resources.null_value();
-                }
+                return select_identifier(val, identifier_, resources);
+            }
+
+            const string_type* identifier() const override
+            {
+                return &identifier_;
             }
 
             std::string to_string(std::size_t indent = 0) const override
@@ -2948,9 +3096,10 @@ namespace jmespath {
         class filter_expression final : public projection_base
         {
             std::vector<token> token_list_;
+            program program_;
         public:
             filter_expression(std::vector<token>&& token_list)
-                : projection_base(operator_kind::projection_op), token_list_(std::move(token_list))
+                : projection_base(operator_kind::projection_op), token_list_(std::move(token_list)), program_(token_list_)
             {
             }
 
@@ -2964,7 +3113,7 @@ namespace jmespath {
 
                 for (auto& item : val.array_range())
                 {
-                    Json j(json_const_pointer_arg, evaluate_tokens(item, token_list_, resources, ec));
+                    Json j(json_const_pointer_arg, program_.run(item, resources, ec));
                     if (is_true(j))
                     {
                         reference jj = this->apply_expressions(item, resources, ec);
@@ -3063,10 +3212,16 @@ namespace jmespath {
         class multi_select_list final : public basic_expression
         {
             std::vector<std::vector<token>> token_lists_;
+            std::vector<program> programs_;
         public:
             multi_select_list(std::vector<std::vector<token>>&& token_lists)
                 : token_lists_(std::move(token_lists))
             {
+                programs_.reserve(token_lists_.size());
+                for (auto& list : token_lists_)
+                {
+                    programs_.emplace_back(list);
+                }
             }
 
             reference evaluate(reference val, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
@@ -3076,11 +3231,11 @@ namespace jmespath {
                     return val;
                 }
                 auto result = resources.create_json(json_array_arg);
-                result->reserve(token_lists_.size());
+                result->reserve(programs_.size());
 
-                for (auto& list : token_lists_)
+                for (auto& prog : programs_)
                 {
-                    result->emplace_back(json_const_pointer_arg, evaluate_tokens(val, list, resources, ec));
+                    result->emplace_back(json_const_pointer_arg, prog.run(val, resources, ec));
                 }
                 return *result;
             }
@@ -3122,10 +3277,16 @@ namespace jmespath {
         {
         public:
             std::vector<key_tokens> key_toks_;
+            std::vector<program> programs_;
 
             multi_select_hash(std::vector<key_tokens>&& key_toks)
                 : key_toks_(std::move(key_toks))
             {
+                programs_.reserve(key_toks_.size());
+                for (auto& item : key_toks_)
+                {
+                    programs_.emplace_back(item.tokens);
+                }
             }
 
             reference evaluate(reference val, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
@@ -3136,9 +3297,9 @@ namespace jmespath {
                 }
                 auto resultp = resources.create_json(json_object_arg);
                 resultp->reserve(key_toks_.size());
-                for (auto& item : key_toks_)
+                for (std::size_t i = 0; i < key_toks_.size(); ++i)
                 {
-                    resultp->try_emplace(item.key, json_const_pointer_arg, evaluate_tokens(val, item.tokens, resources, ec));
+                    resultp->try_emplace(key_toks_[i].key, json_const_pointer_arg, programs_[i].run(val, resources, ec));
                 }
 
                 return *resultp;
@@ -3160,15 +3321,16 @@ namespace jmespath {
         {
         public:
             std::vector<token> toks_;
+            program program_;
 
             function_expression(std::vector<token>&& toks)
-                : toks_(std::move(toks))
+                : toks_(std::move(toks)), program_(toks_)
             {
             }
 
             reference evaluate(reference val, dynamic_resources<Json,JsonReference>& resources, std::error_code& ec) const override
             {
-                return *evaluate_tokens(val, toks_, resources, ec);
+                return *program_.run(val, resources, ec);
             }
 
             std::string to_string(std::size_t indent = 0) const override
@@ -3335,6 +3497,7 @@ namespace jmespath {
         {
             static_resources resources_;
             std::vector<token> output_stack_;
+            program program_;
         public:
             jmespath_expression()
             {
@@ -3345,17 +3508,18 @@ namespace jmespath {
 
             jmespath_expression(jmespath_expression&& expr)
                 : resources_(std::move(expr.resources_)),
-                  output_stack_(std::move(expr.output_stack_))
+                  output_stack_(std::move(expr.output_stack_)),
+                  program_(std::move(expr.program_))
             {
             }
 
             jmespath_expression(static_resources&& resources,
                                 std::vector<token>&& output_stack)
-                : resources_(std::move(resources)), output_stack_(std::move(output_stack))
+                : resources_(std::move(resources)), output_stack_(std::move(output_stack)), program_(output_stack_)
             {
             }
 
-            Json evaluate(reference doc)
+            Json evaluate(reference doc) const
             {
                 if (output_stack_.empty())
                 {
@@ -3370,14 +3534,64 @@ namespace jmespath {
                 return result;
             }
 
-            Json evaluate(reference doc, std::error_code& ec)
+            Json evaluate(reference doc, std::error_code& ec) const
             {
                 if (output_stack_.empty())
                 {
                     return Json::null();
                 }
                 dynamic_resources<Json,JsonReference> dynamic_storage;
-                return deep_copy(*evaluate_tokens(doc, output_stack_, dynamic_storage, ec));
+                return deep_copy(*program_.run(doc, dynamic_storage, ec));
+            }
+
+            // Returns the result without copying it. The result may refer into doc, into this
+            // expression, and into temporaries kept by resources, and is valid for as long as
+            // all three are, or until resources.clear() is called.
+            const Json& evaluate(reference doc, evaluation_resources<Json>& resources) const
+            {
+                std::error_code ec;
+                const Json& result = evaluate(doc, resources, ec);
+                if (ec)
+                {
+                    JSONCONS_THROW(jmespath_error(ec));
+                }
+                return result;
+            }
+
+            const Json& evaluate(reference doc, evaluation_resources<Json>& resources, std::error_code& ec) const
+            {
+                if (output_stack_.empty())
+                {
+                    return resources.resources_.null_value();
+                }
+                return *program_.run(doc, resources.resources_, ec);
+            }
+
+            // Writes the result to visitor, without making a copy of it
+            void evaluate(reference doc, basic_json_visitor<char_type>& visitor) const
+            {
+                std::error_code ec;
+                evaluate(doc, visitor, ec);
+                if (ec)
+                {
+                    JSONCONS_THROW(jmespath_error(ec));
+                }
+            }
+
+            void evaluate(reference doc, basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+            {
+                if (output_stack_.empty())
+                {
+                    Json::null().dump(visitor, ec);
+                    return;
+                }
+                dynamic_resources<Json,JsonReference> dynamic_storage;
+                reference result = *program_.run(doc, dynamic_storage, ec);
+                if (ec)
+                {
+                    return;
+                }
+                result.dump(visitor, ec);
             }
 
             static jmespath_expression compile(const string_view_type& expr)
@@ -5160,17 +5374,103 @@ namespace jmespath {
     template <class Json>
     using jmespath_expression = typename jsoncons::jmespath::detail::jmespath_evaluator<Json,const Json&>::jmespath_expression;
 
+    // Caller owned storage for the temporaries of evaluations that return the result 
+    // without copying it. Not thread safe, use one per thread.
+    template <class Json>
+    class evaluation_resources
+    {
+        friend typename jsoncons::jmespath::detail::jmespath_evaluator<Json,const Json&>::jmespath_expression;
+
+        jsoncons::detail::scratch_arena arena_;
+        jsoncons::jmespath::detail::dynamic_resources<Json,const Json&> resources_;
+    public:
+        evaluation_resources()
+            : resources_(arena_)
+        {
+        }
+
+        evaluation_resources(const evaluation_resources&) = delete;
+        evaluation_resources& operator=(const evaluation_resources&) = delete;
+
+        // Destroys the temporaries of all evaluations so far, invalidating their results.
+        // The memory is kept for the next evaluations.
+        void clear() noexcept
+        {
+            resources_.clear();
+        }
+
+        // Number of temporaries kept
+        std::size_t temp_count() const
+        {
+            return resources_.temp_count();
+        }
+    };
+
+    // A thread safe cache of the most recently used compiled expressions.
+    // A compiled expression may be evaluated concurrently.
+    template <class Json>
+    class jmespath_expression_cache
+    {
+    public:
+        using expression_type = jmespath_expression<Json>;
+        using expression_pointer = std::shared_ptr<const expression_type>;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<typename Json::char_type>;
+
+        static constexpr std::size_t default_capacity = 512;
+    private:
+        jsoncons::detail::lru_cache<string_type,expression_type> cache_;
+    public:
+        explicit jmespath_expression_cache(std::size_t capacity = default_capacity)
+            : cache_(capacity)
+        {
+        }
+
+        expression_pointer get(const string_view_type& expr)
+        {
+            return cache_.get_or_create(string_type(expr.data(), expr.size()), 
+                [&]() {return std::make_shared<expression_type>(expression_type::compile(expr));});
+        }
+
+        // Returns a null pointer if expr fails to compile
+        expression_pointer get(const string_view_type& expr, std::error_code& ec)
+        {
+            return cache_.get_or_create(string_type(expr.data(), expr.size()), 
+                [&]() 
+                {
+                    auto p = std::make_shared<expression_type>(expression_type::compile(expr, ec));
+                    return ec ? expression_pointer() : expression_pointer(std::move(p));
+                });
+        }
+
+        cache_stats stats() const
+        {
+            return cache_.stats();
+        }
+
+        void clear()
+        {
+            cache_.clear();
+        }
+    };
+
+    template <class Json>
+    constexpr std::size_t jmespath_expression_cache<Json>::default_capacity;
+
+    // The cache used by search
+    template <class Json>
+    jmespath_expression_cache<Json>& default_expression_cache()
+    {
+        static jmespath_expression_cache<Json> cache;
+        return cache;
+    }
+
     template<class Json>
     Json search(const Json& doc, const typename Json::string_view_type& path)
     {
-        jsoncons::jmespath::detail::jmespath_evaluator<Json,const Json&> evaluator;
+        auto expr = default_expression_cache<Json>().get(path);
         std::error_code ec;
-        auto expr = evaluator.compile(path.data(), path.size(), ec);
-        if (ec)
-        {
-            JSONCONS_THROW(jmespath_error(ec, evaluator.line(), evaluator.column()));
-        }
-        auto result = expr.evaluate(doc, ec);
+        auto result = expr->evaluate(doc, ec);
         if (ec)
         {
             JSONCONS_THROW(jmespath_error(ec));
@@ -5181,13 +5481,12 @@ namespace jmespath {
     template<class Json>
     Json search(const Json& doc, const typename Json::string_view_type& path, std::error_code& ec)
     {
-        jsoncons::jmespath::detail::jmespath_evaluator<Json,const Json&> evaluator;
-        auto expr = evaluator.compile(path.data(), path.size(), ec);
+        auto expr = default_expression_cache<Json>().get(path, ec);
         if (ec)
         {
             return Json::null();
         }
-        auto result = expr.evaluate(doc, ec);
+        auto result = expr->evaluate(doc, ec);
         if (ec)
         {
             return Json::null();
@@ -9,15 +9,16 @@
 
 #include <string> // std::basic_string
 #include <vector> // std::vector
+#include <memory> // std::unique_ptr
 #include <unordered_map> // std::unordered_map
 #include <unordered_set> // std::unordered_set
 #include <limits> // std::numeric_limits
 #include <set> // std::set
+#include <algorithm> // std::sort, std::min_element
 #include <utility> // std::move
-#if defined(JSONCONS_HAS_STD_REGEX)
-#include <regex>
-#endif
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/regex_engine.hpp>
+#include <jsoncons/detail/scratch_arena.hpp>
 #include <jsoncons_ext/jsonpath/json_location.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
 
@@ -132,7 +133,7 @@ namespace jsonpath {
     };
     constexpr argument_arg_t argument_arg{};
 
-    enum class result_options {value=0, nodups=1, sort=2, path=4};
+    enum class result_options {value=0, nodups=1, sort=2, path=4, first=8, parallel=16};
 
     using result_type = result_options;
 
@@ -375,6 +376,9 @@ namespace detail {
     template <class Json,class JsonReference>
     class dynamic_resources;
 
+    template <class Json,class JsonReference>
+    class selector_optimizer;
+
     template <class Json,class JsonReference>
     struct unary_operator
     {
@@ -401,6 +405,11 @@ namespace detail {
 
         virtual Json evaluate(JsonReference, 
                               std::error_code&) const = 0;
+
+        virtual std::string to_string(int = 0) const
+        {
+            return "unary operator";
+        }
     };
 
     template <class Json>
@@ -432,6 +441,18 @@ namespace detail {
         {
             return is_false(val) ? Json(true) : Json(false);
         }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("not operator");
+            return s;
+        }
     };
 
     template <class Json,class JsonReference>
@@ -458,6 +479,18 @@ namespace detail {
                 return Json::null();
             }
         }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("unary minus operator");
+            return s;
+        }
     };
 
     template <class Json,class JsonReference>
@@ -465,9 +498,9 @@ namespace detail {
     {
         using char_type = typename Json::char_type;
         using string_type = std::basic_string<char_type>;
-        std::basic_regex<char_type> pattern_;
+        std::shared_ptr<const basic_regex_pattern<char_type>> pattern_;
     public:
-        regex_operator(std::basic_regex<char_type>&& pattern)
+        regex_operator(std::shared_ptr<const basic_regex_pattern<char_type>>&& pattern)
             : unary_operator<Json,JsonReference>(2, true),
               pattern_(std::move(pattern))
         {
@@ -483,7 +516,20 @@ namespace detail {
             {
                 return Json::null();
             }
-            return std::regex_search(val.as_string(), pattern_) ? Json(true) : Json(false);
+            auto sv = val.as_string_view();
+            return pattern_->search(sv.data(), sv.size()) ? Json(true) : Json(false);
+        }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("regex operator");
+            return s;
         }
     };
 
@@ -1350,10 +1396,9 @@ namespace detail {
             auto arg0 = args[0].value().template as<string_type>();
             auto arg1 = args[1].value().template as<string_type>();
 
-            std::regex::flag_type options = std::regex_constants::ECMAScript; 
-            std::basic_regex<char_type> pieces_regex(arg1, options);
+            auto pieces_regex = jsoncons::detail::cached_std_regex(arg1);
 
-            std::regex_token_iterator<typename string_type::const_iterator> rit ( arg0.begin(), arg0.end(), pieces_regex, -1);
+            std::regex_token_iterator<typename string_type::const_iterator> rit ( arg0.begin(), arg0.end(), *pieces_regex, -1);
             std::regex_token_iterator<typename string_type::const_iterator> rend;
 
             value_type j(json_array_arg);
@@ -2078,7 +2123,7 @@ namespace detail {
         path_value_pair& operator=(const path_value_pair&) = default;
         path_value_pair& operator=(path_value_pair&& other) = default;
 
-        json_location_type path() const
+        const json_location_type& path() const
         {
             return path_;
         }
@@ -2109,6 +2154,26 @@ namespace detail {
         }
     };
 
+    // Hash and equality of the paths of pointed to nodes, for removing duplicates in one pass
+    template <class Json,class JsonReference>
+    struct path_value_pair_path_hash
+    {
+        std::size_t operator()(const path_value_pair<Json,JsonReference>* node) const noexcept
+        {
+            return node->path().hash();
+        }
+    };
+
+    template <class Json,class JsonReference>
+    struct path_value_pair_path_equal
+    {
+        bool operator()(const path_value_pair<Json,JsonReference>* lhs,
+                        const path_value_pair<Json,JsonReference>* rhs) const noexcept
+        {
+            return lhs->path() == rhs->path();
+        }
+    };
+
     template <class Json,class JsonReference>
     struct path_component_value_pair
     {
@@ -2152,6 +2217,14 @@ namespace detail {
 
         virtual void add(const json_location_node_type& path_tail, 
                          reference value) = 0;
+
+        // True once the receiver wants no more nodes, selectors then stop looking for them
+        bool done() const
+        {
+            return done_;
+        }
+    protected:
+        bool done_ = false;
     };
 
     template <class Json,class JsonReference>
@@ -2191,6 +2264,9 @@ namespace detail {
         }
     };
 
+    // Temporaries made while evaluating an expression. They live in the calling thread's
+    // scratch arena, which keeps its blocks between evaluations, and are destroyed with the
+    // resources.
     template <class Json, class JsonReference>
     class dynamic_resources
     {
@@ -2198,10 +2274,30 @@ namespace detail {
         using pointer = typename std::conditional<std::is_const<typename std::remove_reference<reference>::type>::value,typename Json::const_pointer,typename Json::pointer>::type;
         using json_location_node_type = json_location_node<typename Json::char_type>;
         using path_stem_value_pair_type = path_component_value_pair<Json,JsonReference>;
-        std::vector<std::unique_ptr<Json>> temp_json_values_;
-        std::vector<std::unique_ptr<json_location_node_type>> temp_path_node_values_;
+        jsoncons::detail::scratch_arena& arena_;
+        jsoncons::detail::scratch_arena::mark_type mark_;
         std::unordered_map<std::size_t,pointer> cache_;
+        std::vector<std::unique_ptr<jsoncons::detail::scratch_arena>> worker_arenas_;
+        std::vector<std::unique_ptr<dynamic_resources>> workers_;
     public:
+        dynamic_resources()
+            : arena_(jsoncons::detail::scratch_arena::thread_instance()), mark_(arena_.mark())
+        {
+        }
+
+        explicit dynamic_resources(jsoncons::detail::scratch_arena& arena)
+            : arena_(arena), mark_(arena_.mark())
+        {
+        }
+
+        dynamic_resources(const dynamic_resources&) = delete;
+        dynamic_resources& operator=(const dynamic_resources&) = delete;
+
+        ~dynamic_resources() noexcept
+        {
+            arena_.rewind(mark_);
+        }
+
         bool is_cached(std::size_t id) const
         {
             return cache_.find(id) != cache_.end();
@@ -2224,10 +2320,7 @@ namespace detail {
         template <typename... Args>
         Json* create_json(Args&& ... args)
         {
-            auto temp = jsoncons::make_unique<Json>(std::forward<Args>(args)...);
-            Json* ptr = temp.get();
-            temp_json_values_.emplace_back(std::move(temp));
-            return ptr;
+            return arena_.template create<Json>(std::forward<Args>(args)...);
         }
 
         const json_location_node_type& root_path_node() const
@@ -2245,10 +2338,26 @@ namespace detail {
         template <typename... Args>
         const json_location_node_type* create_path_node(Args&& ... args)
         {
-            auto temp = jsoncons::make_unique<json_location_node_type>(std::forward<Args>(args)...);
-            json_location_node_type* ptr = temp.get();
-            temp_path_node_values_.emplace_back(std::move(temp));
-            return ptr;
+            return arena_.template create<json_location_node_type>(std::forward<Args>(args)...);
+        }
+
+        // Number of temporaries made by this evaluation so far
+        std::size_t temp_count() const
+        {
+            return arena_.object_count() - mark_.object_count;
+        }
+
+        // The resources of one worker of a parallel evaluation, each with an arena of its own. 
+        // They are destroyed with these resources, so the locations and values that the 
+        // workers make remain valid until the evaluation is over.
+        dynamic_resources& worker_resources(std::size_t index)
+        {
+            while (workers_.size() <= index)
+            {
+                worker_arenas_.push_back(jsoncons::make_unique<jsoncons::detail::scratch_arena>());
+                workers_.push_back(jsoncons::make_unique<dynamic_resources>(*worker_arenas_.back()));
+            }
+            return *workers_[index];
         }
     };
 
@@ -2322,6 +2431,24 @@ namespace detail {
         {
         }
 
+        // Returns the selector that takes the place of this one in the optimized plan
+        virtual jsonpath_selector* optimize(selector_optimizer<Json,JsonReference>&)
+        {
+            return this;
+        }
+
+        // The name selected by an identifier selector, null for other selectors
+        virtual const string_type* identifier() const
+        {
+            return nullptr;
+        }
+
+        // The next selector in a chain, null at the end of the chain and for unions
+        virtual jsonpath_selector* tail() const
+        {
+            return nullptr;
+        }
+
         virtual std::string to_string(int = 0) const
         {
             return std::string();
@@ -2440,7 +2567,7 @@ namespace detail {
             return &oper;
         }
 
-        const unary_operator<Json,JsonReference>* get_regex_operator(std::basic_regex<char_type>&& pattern) 
+        const unary_operator<Json,JsonReference>* get_regex_operator(std::shared_ptr<const basic_regex_pattern<char_type>>&& pattern) 
         {
             unary_operators_.push_back(jsoncons::make_unique<regex_operator<Json,JsonReference>>(std::move(pattern)));
             return unary_operators_.back().get();
@@ -2543,6 +2670,46 @@ namespace detail {
         }
     };
 
+    // Rewrites compiled selectors into cheaper equivalents, after the whole path has been
+    // compiled. The alternatives of a union share their tail, so each selector is rewritten once.
+    template <class Json,class JsonReference>
+    class selector_optimizer
+    {
+    public:
+        using selector_type = jsonpath_selector<Json,JsonReference>;
+    private:
+        static_resources<Json,JsonReference>& resources_;
+        std::unordered_map<const selector_type*,selector_type*> optimized_;
+    public:
+        selector_optimizer(static_resources<Json,JsonReference>& resources)
+            : resources_(resources)
+        {
+        }
+
+        selector_type* optimize(selector_type* selector)
+        {
+            if (selector == nullptr)
+            {
+                return nullptr;
+            }
+            auto it = optimized_.find(selector);
+            if (it != optimized_.end())
+            {
+                return it->second;
+            }
+            selector_type* result = selector->optimize(*this);
+            optimized_.emplace(selector, result);
+            optimized_.emplace(result, result);
+            return result;
+        }
+
+        template <typename T>
+        selector_type* new_selector(T&& val)
+        {
+            return resources_.new_selector(std::forward<T>(val));
+        }
+    };
+
     template <class Json, class JsonReference>
     class expression_base
     {
@@ -2566,6 +2733,17 @@ namespace detail {
                                            std::error_code& ec) const = 0;
 
         virtual std::string to_string(int level = 0) const = 0;
+
+        // Simplifies the expression once the whole path has been compiled
+        virtual void optimize(selector_optimizer<Json,JsonReference>&)
+        {
+        }
+
+        // The value of the expression if it is a constant, otherwise null
+        virtual const Json* constant_value() const
+        {
+            return nullptr;
+        }
     };
 
     template <class Json,class JsonReference>
@@ -2906,6 +3084,9 @@ namespace detail {
                     unicode_traits::convert(sbuf.data(), sbuf.size(), s);
                     break;
                 }
+                case jsonpath_token_kind::unary_operator:
+                    s.append(unary_operator_->to_string(level));
+                    break;
                 case jsonpath_token_kind::binary_operator:
                     s.append(binary_operator_->to_string(level));
                     break;
@@ -2931,21 +3112,26 @@ namespace detail {
     class callback_receiver : public node_receiver<Json,JsonReference>
     {
         Callback& callback_;
+        bool first_;
     public:
         using reference = JsonReference;
         using char_type = typename Json::char_type;
         using json_location_node_type = json_location_node<char_type>;
         using json_location_type = json_location<char_type>;
 
-        callback_receiver(Callback& callback)
-            : callback_(callback)
+        callback_receiver(Callback& callback, result_options options = result_options())
+            : callback_(callback), first_((options & result_options::first) == result_options::first)
         {
         }
 
         void add(const json_location_node_type& path_tail, 
                  reference value) override
         {
-            callback_(json_location_type(path_tail), value);
+            if (!this->done_)
+            {
+                callback_(json_location_type(path_tail), value);
+                this->done_ = first_;
+            }
         }
     };
 
@@ -2959,6 +3145,8 @@ namespace detail {
         using path_value_pair_type = path_value_pair<Json,JsonReference>;
         using path_value_pair_less_type = path_value_pair_less<Json,JsonReference>;
         using path_value_pair_equal_type = path_value_pair_equal<Json,JsonReference>;
+        using path_value_pair_path_hash_type = path_value_pair_path_hash<Json,JsonReference>;
+        using path_value_pair_path_equal_type = path_value_pair_path_equal<Json,JsonReference>;
         using value_type = Json;
         using reference = typename path_value_pair_type::reference;
         using pointer = typename path_value_pair_type::value_pointer;
@@ -3032,12 +3220,22 @@ namespace detail {
 
             options |= required_options_;
 
-            const result_options require_more = result_options::nodups | result_options::sort;
+            const bool first = (options & result_options::first) == result_options::first;
+            const bool sort = (options & result_options::sort) == result_options::sort;
+            const bool nodups = (options & result_options::nodups) == result_options::nodups;
 
-            if ((options & require_more) != result_options())
+            // Without sort, the first node found is also the first distinct one, so 
+            // the search can stop there
+            if (sort || (nodups && !first))
             {
                 path_value_receiver<Json,JsonReference> receiver;
                 selector_->select(resources, root, path, current, receiver, options);
+                if (first && receiver.nodes.size() > 1)
+                {
+                    auto it = std::min_element(receiver.nodes.begin(), receiver.nodes.end(), path_value_pair_less_type());
+                    callback(it->path(), it->value());
+                    return;
+                }
 
                 if (receiver.nodes.size() > 1 && (options & result_options::sort) == result_options::sort)
                 {
@@ -3057,26 +3255,16 @@ namespace detail {
                     }
                     else
                     {
-                        std::vector<path_value_pair_type> index(receiver.nodes);
-                        std::sort(index.begin(), index.end(), path_value_pair_less_type());
-                        auto last = std::unique(index.begin(),index.end(),path_value_pair_equal_type());
-                        index.erase(last,index.end());
-
-                        std::vector<path_value_pair_type> temp2;
-                        temp2.reserve(index.size());
-                        for (auto&& node : receiver.nodes)
+                        // keeps the first occurrence of each path, in the original order
+                        std::unordered_set<const path_value_pair_type*,path_value_pair_path_hash_type,path_value_pair_path_equal_type> seen;
+                        seen.reserve(receiver.nodes.size());
+                        for (auto& node : receiver.nodes)
                         {
-                            auto it = std::lower_bound(index.begin(),index.end(),node, path_value_pair_less_type());
-                            if (it != index.end() && it->path() == node.path()) 
+                            if (seen.insert(std::addressof(node)).second)
                             {
-                                temp2.emplace_back(std::move(node));
-                                index.erase(it);
+                                callback(node.path(), node.value());
                             }
                         }
-                        for (auto& node : temp2)
-                        {
-                            callback(node.path(), node.value());
-                        }
                     }
                 }
                 else
@@ -3089,7 +3277,7 @@ namespace detail {
             }
             else
             {
-                callback_receiver<Callback,Json,JsonReference> receiver(callback);
+                callback_receiver<Callback,Json,JsonReference> receiver(callback, options);
                 selector_->select(resources, root, path, current, receiver, options);
             }
         }
@@ -3301,6 +3489,80 @@ namespace detail {
             //}
             return stack.empty() ? Json::null() : stack.back().value();
         }
+
+        // Optimizes the selectors in the expression, and replaces operators whose operands
+        // are all literals with their result. Functions are left alone, a custom function 
+        // need not return the same result for the same arguments.
+        void optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            std::vector<token_type> tokens;
+            tokens.reserve(token_list_.size());
+
+            for (auto& tok : token_list_)
+            {
+                switch (tok.token_kind())
+                {
+                    case jsonpath_token_kind::selector:
+                        tok.selector_ = optimizer.optimize(tok.selector_);
+                        break;
+                    case jsonpath_token_kind::expression:
+                    {
+                        tok.expression_->optimize(optimizer);
+                        const Json* val = tok.expression_->constant_value();
+                        if (val != nullptr)
+                        {
+                            tokens.emplace_back(literal_arg, Json(*val));
+                            continue;
+                        }
+                        break;
+                    }
+                    case jsonpath_token_kind::unary_operator:
+                    {
+                        if (!tokens.empty() && tokens.back().token_kind() == jsonpath_token_kind::literal)
+                        {
+                            std::error_code ec;
+                            Json val = tok.unary_operator_->evaluate(tokens.back().value_, ec);
+                            if (!ec)
+                            {
+                                tokens.back() = token_type(literal_arg, std::move(val));
+                                continue;
+                            }
+                        }
+                        break;
+                    }
+                    case jsonpath_token_kind::binary_operator:
+                    {
+                        std::size_t n = tokens.size();
+                        if (n >= 2 && tokens[n-2].token_kind() == jsonpath_token_kind::literal 
+                                   && tokens[n-1].token_kind() == jsonpath_token_kind::literal)
+                        {
+                            std::error_code ec;
+                            Json val = tok.binary_operator_->evaluate(tokens[n-2].value_, tokens[n-1].value_, ec);
+                            if (!ec)
+                            {
+                                tokens.pop_back();
+                                tokens.back() = token_type(literal_arg, std::move(val));
+                                continue;
+                            }
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+                tokens.emplace_back(std::move(tok));
+            }
+            token_list_ = std::move(tokens);
+        }
+
+        const Json* constant_value() const override
+        {
+            if (token_list_.size() == 1 && token_list_[0].token_kind() == jsonpath_token_kind::literal)
+            {
+                return std::addressof(token_list_[0].value_);
+            }
+            return nullptr;
+        }
  
         std::string to_string(int level) const override
         {
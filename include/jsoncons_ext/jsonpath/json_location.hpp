@@ -15,6 +15,7 @@
 #include <jsoncons/detail/write_number.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/tag_type.hpp>
 
 namespace jsoncons { 
 namespace jsonpath {
@@ -31,26 +32,35 @@ namespace jsonpath {
     public:
         using char_type = CharT;
         using string_type = std::basic_string<CharT>;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
     private:
 
         const json_location_node* parent_;
         json_location_node_kind node_kind_;
         string_type name_;
+        string_view_type name_view_; // refers to name_, or to a name owned by someone else
+        bool owns_name_;
         std::size_t index_;
     public:
         json_location_node(char_type c)
-            : parent_(nullptr), node_kind_(json_location_node_kind::root), index_(0)
+            : parent_(nullptr), node_kind_(json_location_node_kind::root), owns_name_(true), index_(0)
         {
             name_.push_back(c);
         }
 
         json_location_node(const json_location_node* parent, const string_type& name)
-            : parent_(parent), node_kind_(json_location_node_kind::name), name_(name), index_(0)
+            : parent_(parent), node_kind_(json_location_node_kind::name), name_(name), owns_name_(true), index_(0)
+        {
+        }
+
+        // Refers to name without copying it, name must outlive the node
+        json_location_node(const json_location_node* parent, string_view_arg_t, const string_view_type& name)
+            : parent_(parent), node_kind_(json_location_node_kind::name), name_view_(name), owns_name_(false), index_(0)
         {
         }
 
         json_location_node(const json_location_node* parent, std::size_t index)
-            : parent_(parent), node_kind_(json_location_node_kind::index), index_(index)
+            : parent_(parent), node_kind_(json_location_node_kind::index), owns_name_(true), index_(index)
         {
         }
 
@@ -61,9 +71,9 @@ namespace jsonpath {
             return node_kind_;
         }
 
-        const string_type& name() const
+        string_view_type name() const
         {
-            return name_;
+            return owns_name_ ? string_view_type(name_.data(), name_.size()) : name_view_;
         }
 
         std::size_t index() const 
@@ -76,6 +86,8 @@ namespace jsonpath {
             std::swap(parent_, node.parent_);
             std::swap(node_kind_, node.node_kind_);
             std::swap(name_, node.name_);
+            std::swap(name_view_, node.name_view_);
+            std::swap(owns_name_, node.owns_name_);
             std::swap(index_, node.index_);
         }
 
@@ -83,8 +95,16 @@ namespace jsonpath {
 
         std::size_t node_hash() const
         {
-            std::size_t h = node_kind_ == json_location_node_kind::index ? std::hash<std::size_t>{}(index_) : std::hash<string_type>{}(name_);
-
+            if (node_kind_ == json_location_node_kind::index)
+            {
+                return std::hash<std::size_t>{}(index_);
+            }
+            // FNV-1a, hashes the name without copying it
+            std::size_t h = 2166136261u;
+            for (auto c : name())
+            {
+                h = (h ^ static_cast<std::size_t>(c)) * 16777619u;
+            }
             return h;
         }
 
@@ -100,13 +120,13 @@ namespace jsonpath {
                 switch (node_kind_)
                 {
                     case json_location_node_kind::root:
-                        diff = name_.compare(other.name_);
+                        diff = name().compare(other.name());
                         break;
                     case json_location_node_kind::index:
                         diff = index_ < other.index_ ? -1 : index_ > other.index_ ? 1 : 0;
                         break;
                     case json_location_node_kind::name:
-                        diff = name_.compare(other.name_);
+                        diff = name().compare(other.name());
                         break;
                 }
             }
@@ -323,7 +343,7 @@ namespace jsonpath {
                 switch (node->node_kind())
                 {
                     case json_location_node_kind::root:
-                        buffer.append(node->name());
+                        buffer.append(node->name().data(), node->name().size());
                         break;
                     case json_location_node_kind::name:
                         buffer.push_back('[');
@@ -380,12 +400,13 @@ namespace jsonpath {
         {
 
             auto it = nodes_.begin();
-            std::size_t hash = (*it).hash();
+            std::size_t hash = (*it)->node_hash();
             ++it;
 
+            // order sensitive, so that e.g. $[0][1] and $[1][0] differ
             while (it != nodes_.end())
             {
-                hash += 17*(*it)->node_hash();
+                hash ^= (*it)->node_hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
                 ++it;
             }
 
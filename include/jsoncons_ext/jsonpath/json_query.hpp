@@ -19,6 +19,11 @@ namespace jsonpath {
                     result_options options = result_options(),
                     const custom_functions<Json>& functions = custom_functions<Json>())
     {
+        if (functions.begin() == functions.end())
+        {
+            auto expr = default_expression_cache<Json>().get(path);
+            return expr->evaluate(instance, options);
+        }
         auto expr = make_expression<Json>(path, functions);
         return expr.evaluate(instance, options);
     }
@@ -31,56 +36,60 @@ namespace jsonpath {
                result_options options = result_options(),
                const custom_functions<Json>& functions = custom_functions<Json>())
     {
+        if (functions.begin() == functions.end())
+        {
+            auto expr = default_expression_cache<Json>().get(path);
+            expr->evaluate(instance, callback, options);
+            return;
+        }
         auto expr = make_expression<Json>(path, functions);
         expr.evaluate(instance, callback, options);
     }
 
+namespace detail {
+
+    // Compiled expression for json_replace, from the default cache unless there are custom functions
+    template<class Json>
+    std::shared_ptr<const jsonpath_expression<Json,Json&>> 
+    make_replace_expression(const typename Json::string_view_type& path, const custom_functions<Json>& funcs)
+    {
+        if (funcs.begin() == funcs.end())
+        {
+            return default_expression_cache<Json,Json&>().get(path);
+        }
+        return std::make_shared<jsonpath_expression<Json,Json&>>(jsonpath_expression<Json,Json&>::compile(path, funcs));
+    }
+
+} // namespace detail
+
     template<class Json, class T>
     typename std::enable_if<is_json_type_traits_specialized<Json,T>::value,void>::type
         json_replace(Json& instance, const typename Json::string_view_type& path, T&& new_value,
                      result_options options = result_options::nodups,
                      const custom_functions<Json>& funcs = custom_functions<Json>())
     {
-        using evaluator_t = typename jsoncons::jsonpath::detail::jsonpath_evaluator<Json, Json&>;
-        //using string_type = typename evaluator_t::string_type;
-        using value_type = typename evaluator_t::value_type;
-        using reference = typename evaluator_t::reference;
-        using json_selector_t = typename evaluator_t::path_expression_type;
-        using json_location_type = typename evaluator_t::json_location_type;
-
-        jsoncons::jsonpath::detail::static_resources<value_type,reference> static_resources(funcs);
-        evaluator_t e;
-        json_selector_t expr = e.compile(static_resources, path);
-
-        jsoncons::jsonpath::detail::dynamic_resources<Json,reference> resources;
-        auto callback = [&new_value](const json_location_type&, reference v)
+        using json_location_type = typename jsonpath_expression<Json,Json&>::json_location_type;
+
+        auto expr = detail::make_replace_expression<Json>(path, funcs);
+        auto callback = [&new_value](const json_location_type&, Json& v)
         {
             v = std::forward<T>(new_value);
         };
-        expr.evaluate(resources, instance, resources.root_path_node(), instance, callback, options);
+        expr->evaluate(instance, callback, options);
     }
 
     template<class Json, class UnaryCallback>
     typename std::enable_if<type_traits::is_unary_function_object<UnaryCallback,Json>::value,void>::type
     json_replace(Json& instance, const typename Json::string_view_type& path , UnaryCallback callback)
     {
-        using evaluator_t = typename jsoncons::jsonpath::detail::jsonpath_evaluator<Json, Json&>;
-        //using string_type = typename evaluator_t::string_type;
-        using value_type = typename evaluator_t::value_type;
-        using reference = typename evaluator_t::reference;
-        using json_selector_t = typename evaluator_t::path_expression_type;
-        using json_location_type = typename evaluator_t::json_location_type;
-
-        jsoncons::jsonpath::detail::static_resources<value_type,reference> static_resources;
-        evaluator_t e;
-        json_selector_t expr = e.compile(static_resources, path);
-
-        jsoncons::jsonpath::detail::dynamic_resources<Json,reference> resources;
-        auto f = [callback](const json_location_type&, reference v)
+        using json_location_type = typename jsonpath_expression<Json,Json&>::json_location_type;
+
+        auto expr = default_expression_cache<Json,Json&>().get(path);
+        auto f = [callback](const json_location_type&, Json& v)
         {
             v = callback(v);
         };
-        expr.evaluate(resources, instance, resources.root_path_node(), instance, f, result_options::nodups);
+        expr->evaluate(instance, f, result_options::nodups);
     }
 
     template<class Json, class BinaryCallback>
@@ -89,24 +98,14 @@ namespace jsonpath {
                  result_options options = result_options::nodups,
                  const custom_functions<Json>& funcs = custom_functions<Json>())
     {
-        using evaluator_t = typename jsoncons::jsonpath::detail::jsonpath_evaluator<Json, Json&>;
-        //using string_type = typename evaluator_t::string_type;
-        using value_type = typename evaluator_t::value_type;
-        using reference = typename evaluator_t::reference;
-        using json_selector_t = typename evaluator_t::path_expression_type;
-        using json_location_type = typename evaluator_t::json_location_type;
-
-        jsoncons::jsonpath::detail::static_resources<value_type,reference> static_resources(funcs);
-        evaluator_t e;
-        json_selector_t expr = e.compile(static_resources, path);
-
-        jsoncons::jsonpath::detail::dynamic_resources<Json,reference> resources;
+        using json_location_type = typename jsonpath_expression<Json,Json&>::json_location_type;
 
-        auto f = [&callback](const json_location_type& path, reference val)
+        auto expr = detail::make_replace_expression<Json>(path, funcs);
+        auto f = [&callback](const json_location_type& path, Json& val)
         {
             callback(path.to_string(), val);
         };
-        expr.evaluate(resources, instance, resources.root_path_node(), instance, f, options);
+        expr->evaluate(instance, f, options);
     }
 
 } // namespace jsonpath
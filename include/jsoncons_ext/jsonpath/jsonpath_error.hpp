@@ -50,7 +50,8 @@ namespace jsoncons { namespace jsonpath {
         expected_and,
         expected_comma_or_rparen,
         expected_comma_or_rbracket,
-        expected_relative_path
+        expected_relative_path,
+        expected_forward_only_path
     };
 
     class jsonpath_error_category_impl
@@ -133,6 +134,8 @@ namespace jsoncons { namespace jsonpath {
                     return "Expected comma or right parenthesis";
                 case jsonpath_errc::expected_comma_or_rbracket:
                     return "Expected comma or right bracket";
+                case jsonpath_errc::expected_forward_only_path:
+                    return "Expected a path that can be evaluated in one forward pass";
                 case jsonpath_errc::expected_relative_path:
                     return "Expected unquoted string, or single or double quoted string, or index or '*'";
                 default:
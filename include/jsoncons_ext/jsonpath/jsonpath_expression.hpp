@@ -16,6 +16,7 @@
 #include <regex>
 #include <algorithm> // std::reverse
 #include <jsoncons/json.hpp>
+#include <jsoncons/detail/lru_cache.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
 #include <jsoncons_ext/jsonpath/expression.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_selector.hpp>
@@ -1016,13 +1017,8 @@ namespace detail {
                         break;
                     case path_state::regex: 
                     {
-                        std::regex::flag_type options = std::regex_constants::ECMAScript; 
-                        if (buffer2.find('i') != string_type::npos)
-                        {
-                            options |= std::regex_constants::icase;
-                        }
-                        std::basic_regex<char_type> pattern(buffer, options);
-                        push_token(resources, resources.get_regex_operator(std::move(pattern)), ec);
+                        bool icase = buffer2.find('i') != string_type::npos;
+                        push_token(resources, resources.get_regex_operator(jsoncons::compile_regex(buffer, icase)), ec);
                         if (ec) {return path_expression_type();}
                         buffer.clear();
                         buffer2.clear();
@@ -2105,7 +2101,8 @@ namespace detail {
                 return path_expression_type();
             }
 
-            return path_expression_type(output_stack_.back().selector_, paths_required);
+            selector_optimizer<Json,JsonReference> optimizer(resources);
+            return path_expression_type(optimizer.optimize(output_stack_.back().selector_), paths_required);
         }
 
         void advance_past_space_character()
@@ -2516,7 +2513,7 @@ namespace detail {
 
         template <class BinaryCallback>
         typename std::enable_if<type_traits::is_binary_function_object<BinaryCallback,const string_type&,reference>::value,void>::type
-        evaluate(reference instance, BinaryCallback callback, result_options options = result_options())
+        evaluate(reference instance, BinaryCallback callback, result_options options = result_options()) const
         {
             jsoncons::jsonpath::detail::dynamic_resources<Json,reference> resources;
             auto f = [&callback](const json_location_type& path, reference val)
@@ -2526,7 +2523,16 @@ namespace detail {
             expr_.evaluate(resources, instance, resources.root_path_node(), instance, f, options);
         }
 
-        Json evaluate(reference instance, result_options options = result_options())
+        // Like the above, but passes the location without first converting it to a string
+        template <class BinaryCallback>
+        typename std::enable_if<type_traits::is_binary_function_object<BinaryCallback,const json_location_type&,reference>::value,void>::type
+        evaluate(reference instance, BinaryCallback callback, result_options options = result_options()) const
+        {
+            jsoncons::jsonpath::detail::dynamic_resources<Json,reference> resources;
+            expr_.evaluate(resources, instance, resources.root_path_node(), instance, callback, options);
+        }
+
+        Json evaluate(reference instance, result_options options = result_options()) const
         {
             if ((options & result_options::path) == result_options::path)
             {
@@ -2547,6 +2553,12 @@ namespace detail {
             }
         }
 
+        // A description of the optimized evaluation plan
+        std::string to_string() const
+        {
+            return expr_.to_string(0);
+        }
+
         static jsonpath_expression compile(const string_view_type& path)
         {
             jsoncons::jsonpath::detail::static_resources<value_type,reference> resources;
@@ -2606,6 +2618,67 @@ namespace detail {
         return jsonpath_expression<Json>::compile(expr, functions, ec);
     }
 
+    // A thread safe cache of the most recently used compiled expressions, all compiled 
+    // with the same custom functions. A compiled expression may be evaluated concurrently.
+    template <class Json,class JsonReference = const Json&>
+    class jsonpath_expression_cache
+    {
+    public:
+        using expression_type = jsonpath_expression<Json,JsonReference>;
+        using expression_pointer = std::shared_ptr<const expression_type>;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<typename Json::char_type>;
+
+        static constexpr std::size_t default_capacity = 512;
+    private:
+        custom_functions<Json> functions_;
+        jsoncons::detail::lru_cache<string_type,expression_type> cache_;
+    public:
+        explicit jsonpath_expression_cache(std::size_t capacity = default_capacity,
+                                           const custom_functions<Json>& functions = custom_functions<Json>())
+            : functions_(functions), cache_(capacity)
+        {
+        }
+
+        expression_pointer get(const string_view_type& path)
+        {
+            return cache_.get_or_create(string_type(path.data(), path.size()), 
+                [&]() {return std::make_shared<expression_type>(expression_type::compile(path, functions_));});
+        }
+
+        // Returns a null pointer if path fails to compile
+        expression_pointer get(const string_view_type& path, std::error_code& ec)
+        {
+            return cache_.get_or_create(string_type(path.data(), path.size()), 
+                [&]() 
+                {
+                    auto expr = std::make_shared<expression_type>(expression_type::compile(path, functions_, ec));
+                    return ec ? expression_pointer() : expression_pointer(std::move(expr));
+                });
+        }
+
+        cache_stats stats() const
+        {
+            return cache_.stats();
+        }
+
+        void clear()
+        {
+            cache_.clear();
+        }
+    };
+
+    template <class Json,class JsonReference>
+    constexpr std::size_t jsonpath_expression_cache<Json,JsonReference>::default_capacity;
+
+    // The cache used by json_query and json_replace when no custom functions are given
+    template <class Json,class JsonReference = const Json&>
+    jsonpath_expression_cache<Json,JsonReference>& default_expression_cache()
+    {
+        static jsonpath_expression_cache<Json,JsonReference> cache;
+        return cache;
+    }
+
 } // namespace jsonpath
 } // namespace jsoncons
 
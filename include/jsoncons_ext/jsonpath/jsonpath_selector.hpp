@@ -13,6 +13,9 @@
 #include <type_traits> // std::is_const
 #include <limits> // std::numeric_limits
 #include <utility> // std::move
+#include <algorithm> // std::min
+#include <thread>
+#include <exception> // std::exception_ptr
 #include <regex>
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
@@ -134,6 +137,7 @@ namespace detail {
         using char_type = typename Json::char_type;
         using json_location_node_type = json_location_node<char_type>;
         using string_type = std::basic_string<char_type>;
+        using string_view_type = typename json_location_node_type::string_view_type;
 
         static const json_location_node_type& generate(dynamic_resources<Json,JsonReference>& resources,
                                                        const json_location_node_type& last, 
@@ -151,10 +155,29 @@ namespace detail {
             }
         }
 
+        // The node refers to identifier, which is a key in the instance or a name in the
+        // expression, both of which outlive the evaluation
         static const json_location_node_type& generate(dynamic_resources<Json,JsonReference>& resources,
                                                        const json_location_node_type& last, 
                                                        const string_type& identifier, 
                                                        result_options options) 
+        {
+            const result_options require_path = result_options::path | result_options::nodups | result_options::sort;
+            if ((options & require_path) != result_options())
+            {
+                return *resources.create_path_node(&last, string_view_arg, string_view_type(identifier.data(), identifier.size()));
+            }
+            else
+            {
+                return last;
+            }
+        }
+
+        // The node owns a copy of identifier, which is a temporary
+        static const json_location_node_type& generate(dynamic_resources<Json,JsonReference>& resources,
+                                                       const json_location_node_type& last, 
+                                                       string_type&& identifier, 
+                                                       result_options options) 
         {
             const result_options require_path = result_options::path | result_options::nodups | result_options::sort;
             if ((options & require_path) != result_options())
@@ -168,6 +191,105 @@ namespace detail {
         }
     };
 
+    // Calls f(resources, i, receiver, options) for the elements i of an array of the given size, 
+    // in order. With result_options::parallel, a large array is split into ranges that are 
+    // evaluated on separate threads, each with its own resources and without the parallel option. 
+    // The nodes found for each range are passed on to receiver afterwards, in document order.
+    template <class Json,class JsonReference,class F>
+    void for_each_element(dynamic_resources<Json,JsonReference>& resources,
+                          std::size_t size,
+                          node_receiver<Json,JsonReference>& receiver,
+                          result_options options,
+                          F f)
+    {
+        const std::size_t min_parallel_size = 4096;
+        const std::size_t min_range_size = 1024;
+
+        std::size_t thread_count = 0;
+        if ((options & result_options::parallel) == result_options::parallel && 
+            (options & result_options::first) != result_options::first &&
+            size >= min_parallel_size)
+        {
+            thread_count = (std::min)(static_cast<std::size_t>(std::thread::hardware_concurrency()), size/min_range_size);
+        }
+        if (thread_count < 2)
+        {
+            for (std::size_t i = 0; i < size && !receiver.done(); ++i)
+            {
+                f(resources, i, receiver, options);
+            }
+            return;
+        }
+
+        result_options worker_options = options & ~result_options::parallel;
+        std::vector<path_stem_value_receiver<Json,JsonReference>> receivers(thread_count);
+        std::vector<std::exception_ptr> errors(thread_count);
+        std::vector<dynamic_resources<Json,JsonReference>*> worker_resources;
+        for (std::size_t t = 0; t < thread_count; ++t)
+        {
+            worker_resources.push_back(std::addressof(resources.worker_resources(t)));
+        }
+
+        auto work = [&](std::size_t t)
+        {
+            std::size_t first = size*t/thread_count;
+            std::size_t last = size*(t+1)/thread_count;
+            JSONCONS_TRY
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    f(*worker_resources[t], i, receivers[t], worker_options);
+                }
+            }
+            JSONCONS_CATCH(...)
+            {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count-1);
+        JSONCONS_TRY
+        {
+            for (std::size_t t = 1; t < thread_count; ++t)
+            {
+                threads.emplace_back(work, t);
+            }
+        }
+        JSONCONS_CATCH(...)
+        {
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            JSONCONS_RETHROW;
+        }
+        work(0);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (std::size_t t = 0; t < thread_count; ++t)
+        {
+            if (errors[t])
+            {
+                std::rethrow_exception(errors[t]);
+            }
+        }
+        for (auto& worker_receiver : receivers)
+        {
+            for (auto& node : worker_receiver.nodes)
+            {
+                if (receiver.done())
+                {
+                    return;
+                }
+                receiver.add(node.last(), node.value());
+            }
+        }
+    }
+
     template <class Json,class JsonReference>
     class base_selector : public jsonpath_selector<Json,JsonReference>
     {
@@ -206,6 +328,17 @@ namespace detail {
             }
         }
 
+        selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            tail_ = optimizer.optimize(tail_);
+            return this;
+        }
+
+        selector_type* tail() const override
+        {
+            return tail_;
+        }
+
         void tail_select(dynamic_resources<Json,JsonReference>& resources,
                            reference root,
                            const json_location_node_type& last, 
@@ -256,6 +389,9 @@ namespace detail {
         }
     };
 
+    template <class Json,class JsonReference>
+    class identifier_path_selector;
+
     template <class Json,class JsonReference>
     class identifier_selector final : public base_selector<Json,JsonReference>
     {
@@ -271,6 +407,7 @@ namespace detail {
         using string_type = std::basic_string<char_type>;
         using string_view_type = basic_string_view<char_type>;
         using node_receiver_type = typename supertype::node_receiver_type;
+        using selector_type = typename supertype::selector_type;
     private:
         string_type identifier_;
     public:
@@ -280,62 +417,69 @@ namespace detail {
         {
         }
 
-        void select(dynamic_resources<Json,JsonReference>& resources,
-                    reference root,
-                    const json_location_node_type& last, 
-                    reference current,
-                    node_receiver_type& receiver,
-                    result_options options) const override
+        // Looks up identifier in current, as a member name, an array index, or the length of 
+        // an array or string. Returns null if there is no such value, otherwise the value, 
+        // and sets node to its location.
+        static pointer select_identifier(dynamic_resources<Json,JsonReference>& resources,
+                                         const string_type& identifier,
+                                         const json_location_node_type& last, 
+                                         reference current,
+                                         result_options options,
+                                         const json_location_node_type*& node)
         {
-            //std::string buf;
-            //buf.append("identifier selector: ");
-            //unicode_traits::convert(identifier_.data(),identifier_.size(),buf);
-
             static const char_type length_name[] = {'l', 'e', 'n', 'g', 't', 'h', 0};
 
             if (current.is_object())
             {
-                auto it = current.find(identifier_);
+                auto it = current.find(identifier);
                 if (it != current.object_range().end())
                 {
-                    this->tail_select(resources, root, 
-                                        path_generator_type::generate(resources, last, identifier_, options),
-                                        it->value(), receiver, options);
+                    node = std::addressof(path_generator_type::generate(resources, last, identifier, options));
+                    return std::addressof(it->value());
                 }
             }
             else if (current.is_array())
             {
                 int64_t n{0};
-                auto r = jsoncons::detail::to_integer_decimal(identifier_.data(), identifier_.size(), n);
+                auto r = jsoncons::detail::to_integer_decimal(identifier.data(), identifier.size(), n);
                 if (r)
                 {
                     std::size_t index = (n >= 0) ? static_cast<std::size_t>(n) : static_cast<std::size_t>(static_cast<int64_t>(current.size()) + n);
                     if (index < current.size())
                     {
-                        this->tail_select(resources, root, 
-                                            path_generator_type::generate(resources, last, index, options),
-                                            current[index], receiver, options);
+                        node = std::addressof(path_generator_type::generate(resources, last, index, options));
+                        return std::addressof(current[index]);
                     }
                 }
-                else if (identifier_ == length_name && current.size() > 0)
+                else if (identifier == length_name && current.size() > 0)
                 {
-                    pointer ptr = resources.create_json(current.size());
-                    this->tail_select(resources, root, 
-                                        path_generator_type::generate(resources, last, identifier_, options), 
-                                        *ptr, 
-                                        receiver, options);
+                    node = std::addressof(path_generator_type::generate(resources, last, identifier, options));
+                    return resources.create_json(current.size());
                 }
             }
-            else if (current.is_string() && identifier_ == length_name)
+            else if (current.is_string() && identifier == length_name)
             {
                 string_view_type sv = current.as_string_view();
                 std::size_t count = unicode_traits::count_codepoints(sv.data(), sv.size());
-                pointer ptr = resources.create_json(count);
-                this->tail_select(resources, root, 
-                                    path_generator_type::generate(resources, last, identifier_, options), 
-                                    *ptr, receiver, options);
+                node = std::addressof(path_generator_type::generate(resources, last, identifier, options));
+                return resources.create_json(count);
+            }
+            return nullptr;
+        }
+
+        void select(dynamic_resources<Json,JsonReference>& resources,
+                    reference root,
+                    const json_location_node_type& last, 
+                    reference current,
+                    node_receiver_type& receiver,
+                    result_options options) const override
+        {
+            const json_location_node_type* node = nullptr;
+            pointer ptr = select_identifier(resources, identifier_, last, current, options, node);
+            if (ptr != nullptr)
+            {
+                this->tail_select(resources, root, *node, *ptr, receiver, options);
             }
-            //std::cout << "end identifier_selector\n";
         }
 
         reference evaluate(dynamic_resources<Json,JsonReference>& resources,
@@ -345,66 +489,44 @@ namespace detail {
                            result_options options,
                            std::error_code& ec) const override
         {
-            static const char_type length_name[] = {'l', 'e', 'n', 'g', 't', 'h', 0};
-
-            if (current.is_object())
+            const json_location_node_type* node = nullptr;
+            pointer ptr = select_identifier(resources, identifier_, last, current, options, node);
+            if (ptr != nullptr)
             {
-                auto it = current.find(identifier_);
-                if (it != current.object_range().end())
-                {
-                    return this->evaluate_tail(resources, root, 
-                                               path_generator_type::generate(resources, last, identifier_, options),
-                                              it->value(), options, ec);
-                }
-                else
-                {
-                    return resources.null_value();
-                }
+                return this->evaluate_tail(resources, root, *node, *ptr, options, ec);
             }
-            else if (current.is_array())
+            else
             {
-                int64_t n{0};
-                auto r = jsoncons::detail::to_integer_decimal(identifier_.data(), identifier_.size(), n);
-                if (r)
-                {
-                    std::size_t index = (n >= 0) ? static_cast<std::size_t>(n) : static_cast<std::size_t>(static_cast<int64_t>(current.size()) + n);
-                    if (index < current.size())
-                    {
-                        return this->evaluate_tail(resources, root, 
-                                                   path_generator_type::generate(resources, last, index, options),
-                                                   current[index], options, ec);
-                    }
-                    else
-                    {
-                        return resources.null_value();
-                    }
-                }
-                else if (identifier_ == length_name && current.size() > 0)
-                {
-                    pointer ptr = resources.create_json(current.size());
-                    return this->evaluate_tail(resources, root, 
-                                               path_generator_type::generate(resources, last, identifier_, options), 
-                                               *ptr, 
-                                               options, ec);
-                }
-                else
-                {
-                    return resources.null_value();
-                }
+                return resources.null_value();
             }
-            else if (current.is_string() && identifier_ == length_name)
+        }
+
+        // Fuses this selector and the identifier selectors that follow it into one
+        selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            std::vector<string_type> identifiers;
+            identifiers.push_back(identifier_);
+            selector_type* next = this->tail();
+            while (next != nullptr && next->identifier() != nullptr)
             {
-                string_view_type sv = current.as_string_view();
-                std::size_t count = unicode_traits::count_codepoints(sv.data(), sv.size());
-                pointer ptr = resources.create_json(count);
-                return this->evaluate_tail(resources, root, 
-                                           path_generator_type::generate(resources, last, identifier_, options), 
-                                           *ptr, options, ec);
+                identifiers.push_back(*next->identifier());
+                next = next->tail();
             }
-            else
+            if (identifiers.size() == 1)
             {
-                return resources.null_value();
+                return supertype::optimize(optimizer);
             }
+            selector_type* fused = optimizer.new_selector(identifier_path_selector<Json,JsonReference>(std::move(identifiers)));
+            if (next != nullptr)
+            {
+                fused->append_selector(optimizer.optimize(next));
+            }
+            return fused;
+        }
+
+        const string_type* identifier() const override
+        {
+            return std::addressof(identifier_);
         }
 
         std::string to_string(int level = 0) const override
@@ -424,6 +546,90 @@ namespace detail {
         }
     };
 
+    // A chain of identifier selectors fused into one, for a path such as $.store.book.title
+    template <class Json,class JsonReference>
+    class identifier_path_selector final : public base_selector<Json,JsonReference>
+    {
+        using supertype = base_selector<Json,JsonReference>;
+        using identifier_selector_type = identifier_selector<Json,JsonReference>;
+    public:
+        using value_type = typename supertype::value_type;
+        using reference = typename supertype::reference;
+        using pointer = typename supertype::pointer;
+        using path_value_pair_type = typename supertype::path_value_pair_type;
+        using json_location_node_type = typename supertype::json_location_node_type;
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using node_receiver_type = typename supertype::node_receiver_type;
+    private:
+        std::vector<string_type> identifiers_;
+    public:
+
+        identifier_path_selector(std::vector<string_type>&& identifiers)
+            : base_selector<Json,JsonReference>(), identifiers_(std::move(identifiers))
+        {
+        }
+
+        void select(dynamic_resources<Json,JsonReference>& resources,
+                    reference root,
+                    const json_location_node_type& last, 
+                    reference current,
+                    node_receiver_type& receiver,
+                    result_options options) const override
+        {
+            const json_location_node_type* node = std::addressof(last);
+            pointer ptr = std::addressof(current);
+            for (const auto& identifier : identifiers_)
+            {
+                ptr = identifier_selector_type::select_identifier(resources, identifier, *node, *ptr, options, node);
+                if (ptr == nullptr)
+                {
+                    return;
+                }
+            }
+            this->tail_select(resources, root, *node, *ptr, receiver, options);
+        }
+
+        reference evaluate(dynamic_resources<Json,JsonReference>& resources,
+                           reference root,
+                           const json_location_node_type& last, 
+                           reference current, 
+                           result_options options,
+                           std::error_code& ec) const override
+        {
+            const json_location_node_type* node = std::addressof(last);
+            pointer ptr = std::addressof(current);
+            for (const auto& identifier : identifiers_)
+            {
+                ptr = identifier_selector_type::select_identifier(resources, identifier, *node, *ptr, options, node);
+                if (ptr == nullptr)
+                {
+                    return resources.null_value();
+                }
+            }
+            return this->evaluate_tail(resources, root, *node, *ptr, options, ec);
+        }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("identifier path selector");
+            for (const auto& identifier : identifiers_)
+            {
+                s.push_back(' ');
+                unicode_traits::convert(identifier.data(),identifier.size(),s);
+            }
+            s.append(base_selector<Json,JsonReference>::to_string(level+1));
+
+            return s;
+        }
+    };
+
     template <class Json,class JsonReference>
     class root_selector final : public base_selector<Json,JsonReference>
     {
@@ -734,6 +940,21 @@ namespace detail {
                 return resources.null_value();
             }
         }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("index selector ");
+            s.append(std::to_string(index_));
+            s.append(base_selector<Json,JsonReference>::to_string(level+1));
+
+            return s;
+        }
     };
 
     template <class Json,class JsonReference>
@@ -764,17 +985,22 @@ namespace detail {
         {
             if (current.is_array())
             {
-                for (std::size_t i = 0; i < current.size(); ++i)
-                {
-                    this->tail_select(resources, root, 
-                                        path_generator_type::generate(resources, last, i, options), current[i], 
-                                        receiver, options);
-                }
+                for_each_element(resources, current.size(), receiver, options,
+                    [&](dynamic_resources<Json,JsonReference>& res, std::size_t i, node_receiver_type& rcv, result_options opts)
+                    {
+                        this->tail_select(res, root, 
+                                          path_generator_type::generate(res, last, i, opts), current[i], 
+                                          rcv, opts);
+                    });
             }
             else if (current.is_object())
             {
                 for (auto& member : current.object_range())
                 {
+                    if (receiver.done())
+                    {
+                        break;
+                    }
                     this->tail_select(resources, root, 
                                         path_generator_type::generate(resources, last, member.key(), options), 
                                         member.value(), receiver, options);
@@ -811,6 +1037,160 @@ namespace detail {
         }
     };
 
+    // Recursive descent followed by a name, $..name. Looks the name up in every object and, 
+    // if the name is an index or "length", every array, without making locations for the 
+    // values that it passes over.
+    template <class Json,class JsonReference>
+    class recursive_identifier_selector final : public base_selector<Json,JsonReference>
+    {
+        using supertype = base_selector<Json,JsonReference>;
+        using path_generator_type = path_generator<Json,JsonReference>;
+        using identifier_selector_type = identifier_selector<Json,JsonReference>;
+    public:
+        using value_type = typename supertype::value_type;
+        using reference = typename supertype::reference;
+        using pointer = typename supertype::pointer;
+        using path_value_pair_type = typename supertype::path_value_pair_type;
+        using json_location_node_type = typename supertype::json_location_node_type;
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename json_location_node_type::string_view_type;
+        using node_receiver_type = typename supertype::node_receiver_type;
+    private:
+        // A value passed over on the way down, its location is made only if needed
+        struct frame
+        {
+            const frame* parent;
+            string_view_type name;
+            std::size_t index;
+            bool has_name;
+            mutable const json_location_node_type* node;
+        };
+
+        string_type identifier_;
+        bool selects_from_arrays_;
+    public:
+
+        recursive_identifier_selector(const string_type& identifier)
+            : base_selector<Json,JsonReference>(), identifier_(identifier), selects_from_arrays_(false)
+        {
+            static const char_type length_name[] = {'l', 'e', 'n', 'g', 't', 'h', 0};
+
+            int64_t n{0};
+            selects_from_arrays_ = identifier_ == length_name || 
+                jsoncons::detail::to_integer_decimal(identifier_.data(), identifier_.size(), n);
+        }
+
+        void select(dynamic_resources<Json,JsonReference>& resources,
+                    reference root,
+                    const json_location_node_type& last, 
+                    reference current,
+                    node_receiver_type& receiver,
+                    result_options options) const override
+        {
+            const result_options require_path = result_options::path | result_options::nodups | result_options::sort;
+            bool make_locations = (options & require_path) != result_options();
+            frame top{nullptr, string_view_type(), 0, false, std::addressof(last)};
+            select_below(resources, root, top, current, receiver, options, make_locations);
+        }
+
+        reference evaluate(dynamic_resources<Json,JsonReference>& resources,
+                           reference root,
+                           const json_location_node_type& last, 
+                           reference current, 
+                           result_options options,
+                           std::error_code&) const override
+        {
+            auto jptr = resources.create_json(json_array_arg);
+            json_array_receiver<Json,JsonReference> receiver(jptr);
+            select(resources, root, last, current, receiver, options);
+            return *jptr;
+        }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("recursive identifier selector ");
+            unicode_traits::convert(identifier_.data(),identifier_.size(),s);
+            s.append(base_selector<Json,JsonReference>::to_string(level+1));
+
+            return s;
+        }
+    private:
+        // Values are visited in the same order as recursive_selector visits them
+        void select_below(dynamic_resources<Json,JsonReference>& resources,
+                          reference root,
+                          const frame& f,
+                          reference current,
+                          node_receiver_type& receiver,
+                          result_options options,
+                          bool make_locations) const
+        {
+            if (current.is_object())
+            {
+                auto it = current.find(identifier_);
+                if (it != current.object_range().end())
+                {
+                    this->tail_select(resources, root, 
+                                      path_generator_type::generate(resources, location(resources, f), identifier_, options),
+                                      it->value(), receiver, options);
+                }
+                for (auto& member : current.object_range())
+                {
+                    if (receiver.done())
+                    {
+                        break;
+                    }
+                    const auto& key = member.key();
+                    frame child{std::addressof(f), string_view_type(key.data(), key.size()), 0, true, 
+                                make_locations ? nullptr : f.node};
+                    select_below(resources, root, child, member.value(), receiver, options, make_locations);
+                }
+            }
+            else if (current.is_array())
+            {
+                if (selects_from_arrays_)
+                {
+                    const json_location_node_type* node = nullptr;
+                    pointer ptr = identifier_selector_type::select_identifier(resources, identifier_, location(resources, f), 
+                                                                              current, options, node);
+                    if (ptr != nullptr)
+                    {
+                        this->tail_select(resources, root, *node, *ptr, receiver, options);
+                    }
+                }
+                if (make_locations && (options & result_options::parallel) == result_options::parallel)
+                {
+                    // the workers of a parallel evaluation share this location, so it is made first
+                    location(resources, f);
+                }
+                for_each_element(resources, current.size(), receiver, options,
+                    [&](dynamic_resources<Json,JsonReference>& res, std::size_t i, node_receiver_type& rcv, result_options opts)
+                    {
+                        frame child{std::addressof(f), string_view_type(), i, false, 
+                                    make_locations ? nullptr : f.node};
+                        select_below(res, root, child, current[i], rcv, opts, make_locations);
+                    });
+            }
+        }
+
+        static const json_location_node_type& location(dynamic_resources<Json,JsonReference>& resources, const frame& f)
+        {
+            if (f.node == nullptr)
+            {
+                const json_location_node_type& parent = location(resources, *f.parent);
+                f.node = f.has_name ? resources.create_path_node(std::addressof(parent), string_view_arg, f.name) 
+                                    : resources.create_path_node(std::addressof(parent), f.index);
+            }
+            return *f.node;
+        }
+    };
+
     template <class Json,class JsonReference>
     class recursive_selector final : public base_selector<Json,JsonReference>
     {
@@ -824,6 +1204,7 @@ namespace detail {
         using json_location_node_type = typename supertype::json_location_node_type;
         using path_generator_type = path_generator<Json,JsonReference>;
         using node_receiver_type = typename supertype::node_receiver_type;
+        using selector_type = typename supertype::selector_type;
 
         recursive_selector()
             : base_selector<Json,JsonReference>()
@@ -840,17 +1221,22 @@ namespace detail {
             if (current.is_array())
             {
                 this->tail_select(resources, root, last, current, receiver, options);
-                for (std::size_t i = 0; i < current.size(); ++i)
-                {
-                    select(resources, root, 
-                           path_generator_type::generate(resources, last, i, options), current[i], receiver, options);
-                }
+                for_each_element(resources, current.size(), receiver, options,
+                    [&](dynamic_resources<Json,JsonReference>& res, std::size_t i, node_receiver_type& rcv, result_options opts)
+                    {
+                        select(res, root, 
+                               path_generator_type::generate(res, last, i, opts), current[i], rcv, opts);
+                    });
             }
             else if (current.is_object())
             {
                 this->tail_select(resources, root, last, current, receiver, options);
                 for (auto& item : current.object_range())
                 {
+                    if (receiver.done())
+                    {
+                        break;
+                    }
                     select(resources, root, 
                            path_generator_type::generate(resources, last, item.key(), options), item.value(), receiver, options);
                 }
@@ -879,11 +1265,27 @@ namespace detail {
                 s.append("\n");
                 s.append(level*2, ' ');
             }
-            s.append("wildcard selector");
+            s.append("recursive selector");
             s.append(base_selector<Json,JsonReference>::to_string(level));
 
             return s;
         }
+
+        // $..name becomes a recursive identifier selector
+        selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            selector_type* next = this->tail();
+            if (next != nullptr && next->identifier() != nullptr)
+            {
+                selector_type* selector = optimizer.new_selector(recursive_identifier_selector<Json,JsonReference>(*next->identifier()));
+                if (next->tail() != nullptr)
+                {
+                    selector->append_selector(optimizer.optimize(next->tail()));
+                }
+                return selector;
+            }
+            return supertype::optimize(optimizer);
+        }
     };
 
     template <class Json,class JsonReference>
@@ -901,6 +1303,7 @@ namespace detail {
         using path_generator_type = path_generator<Json,JsonReference>;
         using node_receiver_type = typename supertype::node_receiver_type;
         using selector_type = typename supertype::selector_type;
+        using string_type = typename supertype::string_type;
     private:
         std::vector<selector_type*> selectors_;
         selector_type* tail_;
@@ -935,10 +1338,35 @@ namespace detail {
         {
             for (auto& selector : selectors_)
             {
+                if (receiver.done())
+                {
+                    break;
+                }
                 selector->select(resources, root, last, current, receiver, options);
             }
         }
 
+        // A union of one selector, such as a bracketed filter, is replaced by that selector
+        selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            for (auto& selector : selectors_)
+            {
+                selector = optimizer.optimize(selector);
+            }
+            tail_ = optimizer.optimize(tail_);
+            return selectors_.size() == 1 ? selectors_[0] : this;
+        }
+
+        const string_type* identifier() const override
+        {
+            return selectors_.size() == 1 ? selectors_[0]->identifier() : nullptr;
+        }
+
+        selector_type* tail() const override
+        {
+            return selectors_.size() == 1 ? selectors_[0]->tail() : nullptr;
+        }
+
         reference evaluate(dynamic_resources<Json,JsonReference>& resources,
                            reference root,
                            const json_location_node_type& last, 
@@ -992,6 +1420,12 @@ namespace detail {
         {
         }
 
+        typename supertype::selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            expr_.optimize(optimizer);
+            return supertype::optimize(optimizer);
+        }
+
         void select(dynamic_resources<Json,JsonReference>& resources,
                     reference root,
                     const json_location_node_type& last, 
@@ -1001,23 +1435,28 @@ namespace detail {
         {
             if (current.is_array())
             {
-                for (std::size_t i = 0; i < current.size(); ++i)
-                {
-                    std::error_code ec;
-                    value_type r = expr_.evaluate(resources, root, current[i], options, ec);
-                    bool t = ec ? false : detail::is_true(r);
-                    if (t)
+                for_each_element(resources, current.size(), receiver, options,
+                    [&](dynamic_resources<Json,JsonReference>& res, std::size_t i, node_receiver_type& rcv, result_options opts)
                     {
-                        this->tail_select(resources, root, 
-                                            path_generator_type::generate(resources, last, i, options), 
-                                            current[i], receiver, options);
-                    }
-                }
+                        std::error_code ec;
+                        value_type r = expr_.evaluate(res, root, current[i], opts, ec);
+                        bool t = ec ? false : detail::is_true(r);
+                        if (t)
+                        {
+                            this->tail_select(res, root, 
+                                              path_generator_type::generate(res, last, i, opts), 
+                                              current[i], rcv, opts);
+                        }
+                    });
             }
             else if (current.is_object())
             {
                 for (auto& member : current.object_range())
                 {
+                    if (receiver.done())
+                    {
+                        break;
+                    }
                     std::error_code ec;
                     value_type r = expr_.evaluate(resources, root, member.value(), options, ec);
                     bool t = ec ? false : detail::is_true(r);
@@ -1054,6 +1493,7 @@ namespace detail {
             }
             s.append("filter selector ");
             s.append(expr_.to_string(level+1));
+            s.append(base_selector<Json,JsonReference>::to_string(level+1));
 
             return s;
         }
@@ -1080,6 +1520,12 @@ namespace detail {
         {
         }
 
+        typename supertype::selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            expr_.optimize(optimizer);
+            return supertype::optimize(optimizer);
+        }
+
         void select(dynamic_resources<Json,JsonReference>& resources,
                     reference root,
                     const json_location_node_type& last, 
@@ -1200,7 +1646,7 @@ namespace detail {
                     {
                         end = current.size();
                     }
-                    for (int64_t i = start; i < end; i += step)
+                    for (int64_t i = start; i < end && !receiver.done(); i += step)
                     {
                         std::size_t j = static_cast<std::size_t>(i);
                         this->tail_select(resources, root, 
@@ -1218,7 +1664,7 @@ namespace detail {
                     {
                         end = -1;
                     }
-                    for (int64_t i = start; i > end; i += step)
+                    for (int64_t i = start; i > end && !receiver.done(); i += step)
                     {
                         std::size_t j = static_cast<std::size_t>(i);
                         if (j < current.size())
@@ -1243,6 +1689,20 @@ namespace detail {
             select(resources, root, last, current, accum, options);
             return *jptr;
         }
+
+        std::string to_string(int level = 0) const override
+        {
+            std::string s;
+            if (level > 0)
+            {
+                s.append("\n");
+                s.append(level*2, ' ');
+            }
+            s.append("slice selector");
+            s.append(base_selector<Json,JsonReference>::to_string(level+1));
+
+            return s;
+        }
     };
 
     template <class Json,class JsonReference>
@@ -1266,6 +1726,12 @@ namespace detail {
         {
         }
 
+        typename supertype::selector_type* optimize(selector_optimizer<Json,JsonReference>& optimizer) override
+        {
+            expr_.optimize(optimizer);
+            return supertype::optimize(optimizer);
+        }
+
         void select(dynamic_resources<Json,JsonReference>& resources,
                     reference root,
                     const json_location_node_type& last, 
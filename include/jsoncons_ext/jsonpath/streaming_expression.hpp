@@ -0,0 +1,765 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONPATH_STREAMING_EXPRESSION_HPP
+#define JSONCONS_JSONPATH_STREAMING_EXPRESSION_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <limits> // std::numeric_limits
+#include <utility> // std::move
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
+#include <jsoncons_ext/jsonpath/json_location.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath_expression.hpp>
+
+namespace jsoncons {
+namespace jsonpath {
+
+namespace detail {
+
+    enum class stream_selector_kind {name, index, slice, wildcard};
+
+    template <class CharT>
+    struct stream_selector
+    {
+        stream_selector_kind kind;
+        std::basic_string<CharT> name;
+        std::size_t start;
+        std::size_t end;
+        std::size_t step;
+
+        explicit stream_selector(stream_selector_kind kind)
+            : kind(kind), start(0), end(0), step(1)
+        {
+        }
+
+        bool matches(const std::basic_string<CharT>& key) const
+        {
+            return kind == stream_selector_kind::wildcard ||
+                   (kind == stream_selector_kind::name && key == name);
+        }
+
+        bool matches(std::size_t index) const
+        {
+            switch (kind)
+            {
+                case stream_selector_kind::wildcard:
+                    return true;
+                case stream_selector_kind::index:
+                    return index == start;
+                case stream_selector_kind::slice:
+                    return index >= start && index < end && (index - start) % step == 0;
+                default:
+                    return false;
+            }
+        }
+    };
+
+    // One step of a forward only path: a union of selectors or a filter,
+    // applied to the children of the current node, or with recursive set,
+    // to the children of the current node and of all its descendants.
+    template <class Json>
+    struct stream_segment
+    {
+        using char_type = typename Json::char_type;
+
+        bool recursive;
+        std::vector<stream_selector<char_type>> selectors;
+        std::shared_ptr<const jsonpath_expression<Json>> filter; // evaluated on [child]
+
+        stream_segment()
+            : recursive(false)
+        {
+        }
+
+        template <class Key>
+        bool matches(const Key& key) const
+        {
+            for (const auto& sel : selectors)
+            {
+                if (sel.matches(key))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool test_filter(const Json& value) const
+        {
+            Json wrapper(json_array_arg);
+            wrapper.emplace_back(json_const_pointer_arg, std::addressof(value));
+            return !filter->evaluate(wrapper).empty();
+        }
+    };
+
+    template <class Json>
+    class stream_path_parser
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using segment_type = stream_segment<Json>;
+        using selector_type = stream_selector<char_type>;
+    private:
+        const char_type* begin_;
+        const char_type* p_;
+        const char_type* end_;
+    public:
+        std::vector<segment_type> parse(const string_view_type& path, std::error_code& ec)
+        {
+            std::vector<segment_type> segments;
+            begin_ = path.data();
+            p_ = begin_;
+            end_ = begin_ + path.size();
+
+            skip_ws();
+            if (p_ == end_ || *p_ != '$')
+            {
+                ec = jsonpath_errc::expected_root_or_function;
+                return segments;
+            }
+            ++p_;
+            while (true)
+            {
+                skip_ws();
+                if (p_ == end_)
+                {
+                    break;
+                }
+                segment_type seg;
+                switch (*p_)
+                {
+                    case '.':
+                        ++p_;
+                        if (p_ != end_ && *p_ == '.')
+                        {
+                            ++p_;
+                            seg.recursive = true;
+                            if (p_ != end_ && *p_ == '[')
+                            {
+                                ++p_;
+                                parse_bracket(seg, ec);
+                                break;
+                            }
+                        }
+                        parse_dot_name(seg, ec);
+                        break;
+                    case '[':
+                        ++p_;
+                        parse_bracket(seg, ec);
+                        break;
+                    case '^':
+                        ec = jsonpath_errc::expected_forward_only_path;
+                        break;
+                    default:
+                        ec = jsonpath_errc::expected_separator;
+                        break;
+                }
+                if (ec)
+                {
+                    return std::vector<segment_type>();
+                }
+                segments.push_back(std::move(seg));
+            }
+            return segments;
+        }
+
+        std::size_t column() const
+        {
+            return (p_ - begin_) + 1;
+        }
+
+    private:
+        void skip_ws()
+        {
+            while (p_ != end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n'))
+            {
+                ++p_;
+            }
+        }
+
+        void parse_dot_name(segment_type& seg, std::error_code& ec)
+        {
+            if (p_ != end_ && *p_ == '*')
+            {
+                ++p_;
+                seg.selectors.emplace_back(stream_selector_kind::wildcard);
+                return;
+            }
+            const char_type* start = p_;
+            while (p_ != end_ && *p_ != '.' && *p_ != '[' && *p_ != ' ')
+            {
+                if (*p_ == '^')
+                {
+                    ec = jsonpath_errc::expected_forward_only_path;
+                    return;
+                }
+                ++p_;
+            }
+            if (p_ == start)
+            {
+                ec = jsonpath_errc::expected_relative_path;
+                return;
+            }
+            selector_type sel(stream_selector_kind::name);
+            sel.name.assign(start, p_);
+            seg.selectors.push_back(std::move(sel));
+        }
+
+        // after '['
+        void parse_bracket(segment_type& seg, std::error_code& ec)
+        {
+            skip_ws();
+            if (p_ != end_ && *p_ == '?')
+            {
+                ++p_;
+                parse_filter(seg, ec);
+                return;
+            }
+            while (true)
+            {
+                skip_ws();
+                if (p_ == end_)
+                {
+                    ec = jsonpath_errc::expected_rbracket;
+                    return;
+                }
+                if (*p_ == '*')
+                {
+                    ++p_;
+                    seg.selectors.emplace_back(stream_selector_kind::wildcard);
+                }
+                else if (*p_ == '\'' || *p_ == '"')
+                {
+                    selector_type sel(stream_selector_kind::name);
+                    parse_quoted(sel.name, ec);
+                    if (ec) return;
+                    seg.selectors.push_back(std::move(sel));
+                }
+                else if (*p_ == '-' || *p_ == ':' || (*p_ >= '0' && *p_ <= '9'))
+                {
+                    parse_index_or_slice(seg, ec);
+                    if (ec) return;
+                }
+                else
+                {
+                    ec = jsonpath_errc::expected_bracket_specifier_or_union;
+                    return;
+                }
+                skip_ws();
+                if (p_ == end_)
+                {
+                    ec = jsonpath_errc::expected_rbracket;
+                    return;
+                }
+                if (*p_ == ']')
+                {
+                    ++p_;
+                    return;
+                }
+                if (*p_ != ',')
+                {
+                    ec = jsonpath_errc::expected_comma_or_rbracket;
+                    return;
+                }
+                ++p_;
+            }
+        }
+
+        void parse_quoted(string_type& name, std::error_code& ec)
+        {
+            char_type quote = *p_++;
+            while (p_ != end_ && *p_ != quote)
+            {
+                if (*p_ == '\\')
+                {
+                    ++p_;
+                    if (p_ == end_)
+                    {
+                        break;
+                    }
+                    switch (*p_)
+                    {
+                        case '\'': case '"': case '\\': case '/':
+                            name.push_back(*p_);
+                            break;
+                        case 'n': name.push_back('\n'); break;
+                        case 't': name.push_back('\t'); break;
+                        case 'r': name.push_back('\r'); break;
+                        case 'b': name.push_back('\b'); break;
+                        case 'f': name.push_back('\f'); break;
+                        default:
+                            ec = jsonpath_errc::illegal_escaped_character;
+                            return;
+                    }
+                    ++p_;
+                }
+                else
+                {
+                    name.push_back(*p_++);
+                }
+            }
+            if (p_ == end_)
+            {
+                ec = jsonpath_errc::unexpected_eof;
+                return;
+            }
+            ++p_;
+        }
+
+        // Bounds of a forward only slice, a missing bound is returned as -1
+        bool parse_integer(int64_t& value, std::error_code& ec)
+        {
+            skip_ws();
+            bool negative = false;
+            if (p_ != end_ && *p_ == '-')
+            {
+                negative = true;
+                ++p_;
+            }
+            if (p_ == end_ || !(*p_ >= '0' && *p_ <= '9'))
+            {
+                if (negative)
+                {
+                    ec = jsonpath_errc::invalid_number;
+                }
+                return false;
+            }
+            value = 0;
+            while (p_ != end_ && *p_ >= '0' && *p_ <= '9')
+            {
+                value = value*10 + (*p_ - '0');
+                ++p_;
+            }
+            if (negative)
+            {
+                // needs the length of the array
+                ec = jsonpath_errc::expected_forward_only_path;
+            }
+            return true;
+        }
+
+        void parse_index_or_slice(segment_type& seg, std::error_code& ec)
+        {
+            int64_t start = 0;
+            bool has_start = parse_integer(start, ec);
+            if (ec) return;
+            skip_ws();
+            if (p_ == end_ || *p_ != ':')
+            {
+                if (!has_start)
+                {
+                    ec = jsonpath_errc::expected_slice_start;
+                    return;
+                }
+                selector_type sel(stream_selector_kind::index);
+                sel.start = static_cast<std::size_t>(start);
+                seg.selectors.push_back(std::move(sel));
+                return;
+            }
+            ++p_;
+            selector_type sel(stream_selector_kind::slice);
+            sel.start = static_cast<std::size_t>(start);
+            int64_t end = 0;
+            sel.end = parse_integer(end, ec) ? static_cast<std::size_t>(end) : (std::numeric_limits<std::size_t>::max)();
+            if (ec) return;
+            skip_ws();
+            if (p_ != end_ && *p_ == ':')
+            {
+                ++p_;
+                int64_t step = 1;
+                if (parse_integer(step, ec))
+                {
+                    if (step == 0)
+                    {
+                        ec = jsonpath_errc::step_cannot_be_zero;
+                        return;
+                    }
+                    sel.step = static_cast<std::size_t>(step);
+                }
+                if (ec) return;
+            }
+            seg.selectors.push_back(std::move(sel));
+        }
+
+        // after '[?', up to and including the matching ']'
+        void parse_filter(segment_type& seg, std::error_code& ec)
+        {
+            const char_type* start = p_;
+            int depth = 0;
+            while (p_ != end_)
+            {
+                char_type c = *p_;
+                if (c == '\'' || c == '"')
+                {
+                    ++p_;
+                    while (p_ != end_ && *p_ != c)
+                    {
+                        if (*p_ == '\\' && p_+1 != end_)
+                        {
+                            ++p_;
+                        }
+                        ++p_;
+                    }
+                    if (p_ == end_)
+                    {
+                        break;
+                    }
+                }
+                else if (c == '=' && p_+1 != end_ && *(p_+1) == '~')
+                {
+                    // skip the regex literal, which may contain '$', '^' and ']'
+                    p_ += 2;
+                    skip_ws();
+                    if (p_ != end_ && *p_ == '/')
+                    {
+                        ++p_;
+                        while (p_ != end_ && *p_ != '/')
+                        {
+                            if (*p_ == '\\' && p_+1 != end_)
+                            {
+                                ++p_;
+                            }
+                            ++p_;
+                        }
+                        if (p_ == end_)
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        continue;
+                    }
+                }
+                else if (c == '$' || c == '^')
+                {
+                    // would need the root or a parent of the current node
+                    ec = jsonpath_errc::expected_forward_only_path;
+                    return;
+                }
+                else if (c == '(' || c == '[')
+                {
+                    ++depth;
+                }
+                else if (c == ')' || (c == ']' && depth > 0))
+                {
+                    --depth;
+                }
+                else if (c == ']')
+                {
+                    break;
+                }
+                ++p_;
+            }
+            if (p_ == end_)
+            {
+                ec = jsonpath_errc::expected_rbracket;
+                return;
+            }
+            string_type text;
+            text.push_back('$');
+            text.push_back('[');
+            text.push_back('?');
+            text.append(start, p_);
+            text.push_back(']');
+            ++p_;
+
+            auto expr = jsonpath_expression<Json>::compile(string_view_type(text.data(), text.size()), ec);
+            if (ec) return;
+            seg.filter = std::make_shared<jsonpath_expression<Json>>(std::move(expr));
+        }
+    };
+
+} // namespace detail
+
+    // A JSONPath expression restricted to what can be evaluated in one forward pass over
+    // the events of a staj cursor. Unmatched values are skipped, matched values are decoded.
+    template <class Json>
+    class streaming_expression
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using json_location_node_type = json_location_node<char_type>;
+        using json_location_type = json_location<char_type>;
+    private:
+        using segment_type = detail::stream_segment<Json>;
+
+        // indices into segments_, segments_.size() means the whole path has matched
+        using state_set = std::vector<std::size_t>;
+
+        std::vector<segment_type> segments_;
+
+        explicit streaming_expression(std::vector<segment_type>&& segments)
+            : segments_(std::move(segments))
+        {
+        }
+    public:
+        static streaming_expression compile(const string_view_type& path)
+        {
+            std::error_code ec;
+            detail::stream_path_parser<Json> parser;
+            auto segments = parser.parse(path, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(jsonpath_error(ec, 1, parser.column()));
+            }
+            return streaming_expression(std::move(segments));
+        }
+
+        static streaming_expression compile(const string_view_type& path, std::error_code& ec)
+        {
+            detail::stream_path_parser<Json> parser;
+            return streaming_expression(parser.parse(path, ec));
+        }
+
+        // Calls callback(path, value) for each match, in document order, reading the value
+        // at the cursor's current event and leaving the cursor on the value's last event.
+        template <class BinaryCallback>
+        void evaluate(basic_staj_cursor<char_type>& cursor, BinaryCallback callback) const
+        {
+            json_location_node_type root('$');
+            state_set states{0};
+            std::deque<json_location_node_type> nodes;
+            stream_value(cursor, root, states, nodes, callback);
+        }
+
+        Json evaluate(basic_staj_cursor<char_type>& cursor) const
+        {
+            Json result(json_array_arg);
+            evaluate(cursor, [&result](const string_type&, const Json& val){result.push_back(val);});
+            return result;
+        }
+
+    private:
+        static void add_state(state_set& states, std::size_t state)
+        {
+            for (auto s : states)
+            {
+                if (s == state)
+                {
+                    return;
+                }
+            }
+            states.push_back(state);
+        }
+
+        bool is_match(const state_set& states) const
+        {
+            for (auto s : states)
+            {
+                if (s == segments_.size())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The states of a child with the given key, filters are tested on the child if given.
+        // Returns true if a filter needs the child before the states are known.
+        template <class Key>
+        bool child_states(const state_set& states, const Key& key, const Json* child, state_set& result) const
+        {
+            bool needs_value = false;
+            result.clear();
+            for (auto s : states)
+            {
+                if (s == segments_.size())
+                {
+                    continue;
+                }
+                const segment_type& seg = segments_[s];
+                if (seg.recursive)
+                {
+                    add_state(result, s);
+                }
+                if (seg.filter)
+                {
+                    if (child == nullptr)
+                    {
+                        needs_value = true;
+                    }
+                    else if (seg.test_filter(*child))
+                    {
+                        add_state(result, s+1);
+                    }
+                }
+                else if (seg.matches(key))
+                {
+                    add_state(result, s+1);
+                }
+            }
+            return needs_value;
+        }
+
+        template <class BinaryCallback>
+        void walk_value(const Json& value, const json_location_node_type& location, const state_set& states,
+                        BinaryCallback& callback) const
+        {
+            if (is_match(states))
+            {
+                callback(json_location_type(location).to_string(), value);
+            }
+            state_set next;
+            if (value.is_object())
+            {
+                for (const auto& member : value.object_range())
+                {
+                    string_type key(member.key().data(), member.key().size());
+                    child_states(states, key, std::addressof(member.value()), next);
+                    if (!next.empty())
+                    {
+                        json_location_node_type node(std::addressof(location), key);
+                        walk_value(member.value(), node, next, callback);
+                    }
+                }
+            }
+            else if (value.is_array())
+            {
+                for (std::size_t i = 0; i < value.size(); ++i)
+                {
+                    child_states(states, i, std::addressof(value[i]), next);
+                    if (!next.empty())
+                    {
+                        json_location_node_type node(std::addressof(location), i);
+                        walk_value(value[i], node, next, callback);
+                    }
+                }
+            }
+        }
+
+        static Json decode_value(basic_staj_cursor<char_type>& cursor)
+        {
+            json_decoder<Json> decoder;
+            cursor.read_to(decoder);
+            return decoder.get_result();
+        }
+
+        static void skip_value(basic_staj_cursor<char_type>& cursor)
+        {
+            std::size_t depth = 0;
+            do
+            {
+                switch (cursor.current().event_type())
+                {
+                    case staj_event_type::begin_array:
+                    case staj_event_type::begin_object:
+                        ++depth;
+                        break;
+                    case staj_event_type::end_array:
+                    case staj_event_type::end_object:
+                        --depth;
+                        break;
+                    default:
+                        break;
+                }
+                if (depth > 0)
+                {
+                    cursor.next();
+                }
+            }
+            while (depth > 0);
+        }
+
+        template <class Key,class BinaryCallback>
+        void stream_child(basic_staj_cursor<char_type>& cursor, const json_location_node_type& location,
+                          const state_set& states, const Key& key,
+                          std::deque<json_location_node_type>& nodes, BinaryCallback& callback) const
+        {
+            state_set next;
+            bool needs_value = child_states(states, key, nullptr, next);
+            if (needs_value)
+            {
+                Json value = decode_value(cursor);
+                child_states(states, key, std::addressof(value), next);
+                if (!next.empty())
+                {
+                    json_location_node_type node(std::addressof(location), key);
+                    walk_value(value, node, next, callback);
+                }
+            }
+            else if (next.empty())
+            {
+                skip_value(cursor);
+            }
+            else
+            {
+                nodes.emplace_back(std::addressof(location), key);
+                stream_value(cursor, nodes.back(), next, nodes, callback);
+                nodes.pop_back();
+            }
+        }
+
+        template <class BinaryCallback>
+        void stream_value(basic_staj_cursor<char_type>& cursor, const json_location_node_type& location,
+                          const state_set& states, std::deque<json_location_node_type>& nodes,
+                          BinaryCallback& callback) const
+        {
+            if (is_match(states))
+            {
+                Json value = decode_value(cursor);
+                walk_value(value, location, states, callback);
+                return;
+            }
+            switch (cursor.current().event_type())
+            {
+                case staj_event_type::begin_object:
+                    cursor.next();
+                    while (cursor.current().event_type() != staj_event_type::end_object)
+                    {
+                        auto sv = cursor.current().template get<string_view_type>();
+                        string_type key(sv.data(), sv.size());
+                        cursor.next();
+                        stream_child(cursor, location, states, key, nodes, callback);
+                        cursor.next();
+                    }
+                    break;
+                case staj_event_type::begin_array:
+                {
+                    cursor.next();
+                    std::size_t index = 0;
+                    while (cursor.current().event_type() != staj_event_type::end_array)
+                    {
+                        stream_child(cursor, location, states, index, nodes, callback);
+                        cursor.next();
+                        ++index;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    };
+
+    template <class Json>
+    streaming_expression<Json> make_streaming_expression(const typename Json::string_view_type& path)
+    {
+        return streaming_expression<Json>::compile(path);
+    }
+
+    template <class Json>
+    streaming_expression<Json> make_streaming_expression(const typename Json::string_view_type& path,
+                                                         std::error_code& ec)
+    {
+        return streaming_expression<Json>::compile(path, ec);
+    }
+
+} // namespace jsonpath
+} // namespace jsoncons
+
+#endif
@@ -18,7 +18,7 @@
 #include <iostream>
 #include <cassert>
 #if defined(JSONCONS_HAS_STD_REGEX)
-#include <regex>
+#include <jsoncons/regex_engine.hpp>
 #endif
 
 namespace jsoncons {
@@ -950,7 +950,7 @@ namespace jsonschema {
 #if defined(JSONCONS_HAS_STD_REGEX)
         try 
         {
-            std::regex re(value, std::regex::ECMAScript);
+            compile_regex(value);
         } 
         catch (const std::exception& e) 
         {
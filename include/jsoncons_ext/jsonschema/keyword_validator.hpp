@@ -19,7 +19,7 @@
 #include <iostream>
 #include <cassert>
 #if defined(JSONCONS_HAS_STD_REGEX)
-#include <regex>
+#include <jsoncons/regex_engine.hpp>
 #endif
 
 namespace jsoncons {
@@ -116,7 +116,7 @@ namespace jsonschema {
         std::string min_length_location_;
 
     #if defined(JSONCONS_HAS_STD_REGEX)
-        jsoncons::optional<std::regex> pattern_;
+        std::shared_ptr<const regex_pattern> pattern_;
         std::string pattern_string_;
         std::string pattern_location_;
     #endif
@@ -172,7 +172,7 @@ namespace jsonschema {
             if (it != sch.object_range().end()) 
             {
                 pattern_string_ = it->value().template as<std::string>();
-                pattern_ = std::regex(it->value().template as<std::string>(),std::regex::ECMAScript);
+                pattern_ = compile_regex(pattern_string_);
                 pattern_location_ = make_absolute_keyword_location(uris, "pattern");
             }
     #endif
@@ -335,7 +335,7 @@ namespace jsonschema {
     #if defined(JSONCONS_HAS_STD_REGEX)
             if (pattern_)
             {
-                if (!std::regex_search(content, *pattern_))
+                if (!pattern_->search(content))
                 {
                     std::string message("String \"");
                     message.append(instance.template as<std::string>());
@@ -903,7 +903,7 @@ namespace jsonschema {
 
         std::map<std::string, validator_pointer> properties_;
     #if defined(JSONCONS_HAS_STD_REGEX)
-        std::vector<std::pair<std::regex, validator_pointer>> pattern_properties_;
+        std::vector<std::pair<std::shared_ptr<const regex_pattern>, validator_pointer>> pattern_properties_;
     #endif
         validator_pointer additional_properties_;
 
@@ -959,7 +959,7 @@ namespace jsonschema {
                 for (const auto& prop : it->value().object_range())
                     pattern_properties_.emplace_back(
                         std::make_pair(
-                            std::regex(prop.key(), std::regex::ECMAScript),
+                            compile_regex(prop.key()),
                             builder->make_keyword_validator(prop.value(), uris, {prop.key()})));
             }
     #endif
@@ -1060,7 +1060,7 @@ namespace jsonschema {
 
                 // check all matching "patternProperties"
                 for (auto& schema_pp : pattern_properties_)
-                    if (std::regex_search(property.key(), schema_pp.first)) 
+                    if (schema_pp.first->search(property.key().data(), property.key().size())) 
                     {
                         a_prop_or_pattern_matched = true;
                         jsonpointer::json_pointer pointer(instance_location);
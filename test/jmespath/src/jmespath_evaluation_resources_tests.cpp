@@ -0,0 +1,164 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons_ext/jmespath/jmespath.hpp>
+#include <catch/catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string people = R"(
+{
+    "people": [
+        {"name": "Bob", "age": 20, "address": {"city": "Toronto"}},
+        {"name": "Fred", "age": 25, "address": {"city": "Montreal"}},
+        {"name": "George", "age": 30, "address": {"city": "Ottawa"}}
+    ],
+    "owner": "Alice"
+}
+)";
+
+    json make_items(std::size_t count)
+    {
+        json items(json_array_arg);
+        items.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json item(json_object_arg);
+            item.try_emplace("id", i);
+            item.try_emplace("name", "item" + std::to_string(i));
+            item.try_emplace("tags", json::parse(R"(["a","b","c"])"));
+            items.push_back(std::move(item));
+        }
+        json doc(json_object_arg);
+        doc.try_emplace("items", std::move(items));
+        return doc;
+    }
+
+} // namespace
+
+TEST_CASE("jmespath evaluate without copying the result")
+{
+    json doc = json::parse(people);
+
+    const char* exprs[] = {
+        "people",
+        "people[*].address",
+        "people[?age > `20`].{name: name, city: address.city}",
+        "sort_by(people, &age)[-1]",
+        "owner",
+        "nothing",
+        "`[1,2]`"
+    };
+
+    SECTION("view")
+    {
+        jmespath::evaluation_resources<json> resources;
+        for (auto s : exprs)
+        {
+            INFO(s);
+            auto expr = jmespath::make_expression<json>(s);
+            const json& result = expr.evaluate(doc, resources);
+            CHECK(result == expr.evaluate(doc));
+        }
+    }
+
+    SECTION("view refers into the document")
+    {
+        jmespath::evaluation_resources<json> resources;
+        auto expr = jmespath::make_expression<json>("people");
+        const json& result = expr.evaluate(doc, resources);
+        CHECK(&result == &doc.at("people"));
+        CHECK(resources.temp_count() == 0);
+    }
+
+    SECTION("clear")
+    {
+        jmespath::evaluation_resources<json> resources;
+        auto expr = jmespath::make_expression<json>("people[*].name");
+        const json& result = expr.evaluate(doc, resources);
+        CHECK(result == json::parse(R"(["Bob","Fred","George"])"));
+        CHECK(resources.temp_count() > 0);
+        resources.clear();
+        CHECK(resources.temp_count() == 0);
+        CHECK(expr.evaluate(doc, resources) == json::parse(R"(["Bob","Fred","George"])"));
+    }
+
+    SECTION("visitor")
+    {
+        for (auto s : exprs)
+        {
+            INFO(s);
+            auto expr = jmespath::make_expression<json>(s);
+            std::string output;
+            json_string_encoder encoder(output);
+            expr.evaluate(doc, encoder);
+            CHECK(json::parse(output) == expr.evaluate(doc));
+
+            json_decoder<json> decoder;
+            expr.evaluate(doc, decoder);
+            CHECK(decoder.get_result() == expr.evaluate(doc));
+        }
+    }
+
+    SECTION("errors")
+    {
+        std::error_code ec;
+        jmespath::evaluation_resources<json> resources;
+        auto expr = jmespath::make_expression<json>("abs(owner)");
+        expr.evaluate(doc, resources, ec);
+        CHECK(ec == jmespath::jmespath_errc::invalid_type);
+        CHECK_THROWS_AS(expr.evaluate(doc, resources), jmespath::jmespath_error);
+
+        ec = std::error_code();
+        std::string output;
+        json_string_encoder encoder(output);
+        expr.evaluate(doc, encoder, ec);
+        CHECK(ec == jmespath::jmespath_errc::invalid_type);
+        CHECK_THROWS_AS(expr.evaluate(doc, encoder), jmespath::jmespath_error);
+    }
+}
+
+TEST_CASE("jmespath evaluate without copying benchmark", "[.benchmark]")
+{
+    json doc = make_items(200000);
+    auto expr = jmespath::make_expression<json>("items[?id > `1000`]");
+
+    auto start = std::chrono::steady_clock::now();
+    json copy = expr.evaluate(doc);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "copy:    " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << copy.size() << " results\n";
+
+    jmespath::evaluation_resources<json> resources;
+    start = std::chrono::steady_clock::now();
+    const json& view = expr.evaluate(doc, resources);
+    end = std::chrono::steady_clock::now();
+    std::cout << "view:    " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << view.size() << " results\n";
+
+    std::string output;
+    start = std::chrono::steady_clock::now();
+    json_string_encoder encoder(output);
+    expr.evaluate(doc, encoder);
+    end = std::chrono::steady_clock::now();
+    std::cout << "visitor: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << output.size() << " bytes\n";
+
+    output.clear();
+    start = std::chrono::steady_clock::now();
+    json_string_encoder encoder2(output);
+    expr.evaluate(doc).dump(encoder2);
+    end = std::chrono::steady_clock::now();
+    std::cout << "copy and dump: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << output.size() << " bytes\n";
+}
@@ -8,6 +8,8 @@
 #include <jsoncons_ext/jmespath/jmespath.hpp>
 #include <catch/catch.hpp>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using jsoncons::json;
 namespace jmespath = jsoncons::jmespath;
@@ -75,3 +77,88 @@ TEST_CASE("jmespath_expression tests")
     }    
 }
 
+
+TEST_CASE("jmespath_expression_cache tests")
+{
+    json doc = json::parse(R"({"people":[{"name":"a","age":20},{"name":"b","age":40}]})");
+
+    SECTION("hits, misses and evictions")
+    {
+        jmespath::jmespath_expression_cache<json> cache(1);
+        auto e1 = cache.get("people[*].name");
+        CHECK(e1 == cache.get("people[*].name"));
+        CHECK(e1->evaluate(doc) == json::parse(R"(["a","b"])"));
+        cache.get("people[0]");
+        auto stats = cache.stats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 2);
+        CHECK(stats.evictions == 1);
+        CHECK(stats.size == 1);
+    }
+
+    SECTION("compile errors")
+    {
+        jmespath::jmespath_expression_cache<json> cache;
+        std::error_code ec;
+        CHECK(cache.get("people[", ec) == nullptr);
+        CHECK(ec);
+        CHECK_THROWS_AS(cache.get("people["), jmespath::jmespath_error);
+
+        ec = std::error_code();
+        CHECK(jmespath::search(doc, "people[", ec) == json::null());
+        CHECK(ec);
+    }
+
+    SECTION("search uses the default cache")
+    {
+        auto before = jmespath::default_expression_cache<json>().stats();
+        CHECK(jmespath::search(doc, "people[?age > `30`].name") == json::parse(R"(["b"])"));
+        CHECK(jmespath::search(doc, "people[?age > `30`].name") == json::parse(R"(["b"])"));
+        auto after = jmespath::default_expression_cache<json>().stats();
+        CHECK(after.hits - before.hits >= 1);
+    }
+
+    SECTION("concurrent evaluation")
+    {
+        auto expr = jmespath::default_expression_cache<json>().get("sort_by(people, &age)[-1].name");
+        std::vector<std::thread> threads;
+        std::vector<int> ok(4, 0);
+        for (std::size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (int i = 0; i < 200; ++i)
+                {
+                    if (expr->evaluate(doc) == json("b"))
+                    {
+                        ++ok[t];
+                    }
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        for (auto n : ok)
+        {
+            CHECK(n == 200);
+        }
+    }
+}
+
+TEST_CASE("jmespath temporaries are released after each evaluation")
+{
+    json doc = json::parse(R"([{"a":"first","tags":[1,2]},{"a":"second","tags":[1]},{"a":"third","tags":[]}])");
+    auto& arena = jsoncons::detail::scratch_arena::thread_instance();
+    std::size_t count = arena.object_count();
+
+    auto expr = jmespath::make_expression<json>("[?length(tags) > `0`].a");
+    for (int i = 0; i < 3; ++i)
+    {
+        json result = expr.evaluate(doc);
+        REQUIRE(result.size() == 2);
+        CHECK(result[1].as<std::string>() == "second");
+        CHECK(arena.object_count() == count);
+    }
+}
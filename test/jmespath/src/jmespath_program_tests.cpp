@@ -0,0 +1,96 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jmespath/jmespath.hpp>
+#include <catch/catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string people = R"(
+{
+    "people": [
+        {"name": "Bob", "age": 20, "tags": ["a", "b"]},
+        {"name": "Fred", "age": 25, "tags": []},
+        {"name": "George", "age": 30, "tags": ["c"]}
+    ],
+    "owner": {"name": "Alice", "address": {"city": "Toronto"}}
+}
+)";
+
+} // namespace
+
+TEST_CASE("jmespath compiled program tests")
+{
+    json doc = json::parse(people);
+
+    SECTION("identifiers")
+    {
+        CHECK(jmespath::search(doc, "owner.address.city") == json("Toronto"));
+        CHECK(jmespath::search(doc, "owner.address.country").is_null());
+        CHECK(jmespath::search(doc, "owner.name.first").is_null());
+        CHECK(jmespath::search(doc, "people[].name") == json::parse(R"(["Bob","Fred","George"])"));
+
+        ojson odoc = ojson::parse(people);
+        CHECK(jmespath::search(odoc, "owner.address.city") == ojson("Toronto"));
+    }
+
+    SECTION("operators, pipes and multi-selects")
+    {
+        CHECK(jmespath::search(doc, "people[?age > `20` && !contains(tags, 'c')].name") == json::parse(R"(["Fred"])"));
+        CHECK(jmespath::search(doc, "people[*].{n: name, a: contains(tags, 'a')}") ==
+              json::parse(R"([{"n":"Bob","a":true},{"n":"Fred","a":false},{"n":"George","a":false}])"));
+        CHECK(jmespath::search(doc, "owner | [name, address.city]") == json::parse(R"(["Alice","Toronto"])"));
+    }
+
+    SECTION("functions")
+    {
+        CHECK(jmespath::search(doc, "sort_by(people, &age)[-1].name") == json("George"));
+        CHECK(jmespath::search(doc, "max_by(people, &length(tags)).name") == json("Bob"));
+        CHECK(jmespath::search(doc, "sum(map(&age, people))") == json(75.0));
+        CHECK(jmespath::search(doc, "join(', ', people[].name)") == json("Bob, Fred, George"));
+    }
+
+    SECTION("stack deeper than the inline stack")
+    {
+        std::string expr = "owner.name";
+        for (int i = 0; i < 20; ++i)
+        {
+            expr = "people[" + std::to_string(i % 3) + "].nothing || (" + expr + ")";
+        }
+        CHECK(jmespath::search(doc, expr) == json("Alice"));
+    }
+
+    SECTION("invalid arity")
+    {
+        std::error_code ec;
+        jmespath::make_expression<json>("abs(people, owner)", ec);
+        CHECK(ec == jmespath::jmespath_errc::invalid_arity);
+    }
+}
+
+TEST_CASE("jmespath compiled program benchmark", "[.benchmark]")
+{
+    json doc = json::parse(people);
+    auto expr = jmespath::make_expression<json>("people[?age > `20`].{name: name, city: address.city, tags: length(tags), first: tags[0]}");
+
+    const std::size_t count = 200000;
+    std::size_t size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        size += expr.evaluate(doc).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << count << " evaluations: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << size << " results\n";
+}
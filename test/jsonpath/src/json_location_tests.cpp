@@ -54,3 +54,26 @@ TEST_CASE("test json_location with solidus to_string")
 }
 
 
+
+TEST_CASE("test json_location with names that refer to keys")
+{
+    std::string foo = "foo's";
+    std::string bar = "bar";
+
+    json_location_node component1('$');
+    json_location_node component2(&component1, jsoncons::string_view_arg, foo);
+    json_location_node component3(&component2, jsoncons::string_view_arg, bar);
+    json_location_node component4(&component3,0);
+
+    json_location_node component11('$');
+    json_location_node component12(&component11,"foo's");
+    json_location_node component13(&component12,"bar");
+    json_location_node component14(&component13,0);
+
+    json_location path1(component4);
+    json_location path2(component14);
+
+    CHECK(component2.name().data() == foo.data());
+    CHECK(path1 == path2);
+    CHECK(path1.to_string() == std::string(R"($['foo\'s']['bar'][0])"));
+}
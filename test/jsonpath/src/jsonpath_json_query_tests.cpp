@@ -16,6 +16,8 @@
 #include <new>
 #include <unordered_set> // std::unordered_set
 #include <fstream>
+#include <thread>
+#include <chrono>
 
 using namespace jsoncons;
 
@@ -120,3 +122,202 @@ TEST_CASE("jsonpath json_query wjson test")
     }
 }
 
+
+TEST_CASE("jsonpath_expression_cache tests")
+{
+    json doc = json::parse(R"({"books":[{"title":"A","price":5},{"title":"B","price":15}]})");
+
+    SECTION("hits, misses and evictions")
+    {
+        jsonpath::jsonpath_expression_cache<json> cache(2);
+
+        auto e1 = cache.get("$.books[*].title");
+        CHECK(e1 == cache.get("$.books[*].title"));
+        CHECK(e1->evaluate(doc) == json::parse(R"(["A","B"])"));
+
+        cache.get("$.books[0]");
+        cache.get("$.books[1]"); // evicts the least recently used
+        auto stats = cache.stats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 3);
+        CHECK(stats.evictions == 1);
+        CHECK(stats.size == 2);
+        CHECK(stats.capacity == 2);
+
+        // still usable after eviction
+        CHECK(e1->evaluate(doc).size() == 2);
+        CHECK(e1 != cache.get("$.books[*].title"));
+    }
+
+    SECTION("compile errors are not cached")
+    {
+        jsonpath::jsonpath_expression_cache<json> cache;
+        std::error_code ec;
+        CHECK(cache.get("$.books[", ec) == nullptr);
+        CHECK(ec);
+        CHECK_THROWS_AS(cache.get("$.books["), jsonpath::jsonpath_error);
+        CHECK(cache.stats().size == 0);
+    }
+
+    SECTION("custom functions")
+    {
+        jsonpath::custom_functions<json> functions;
+        functions.register_function("twice", 1,
+            [](jsoncons::span<const jsonpath::parameter<json>> params, std::error_code&) -> json
+            {
+                return json(params[0].value().as<int>() * 2);
+            });
+        jsonpath::jsonpath_expression_cache<json> cache(16, functions);
+        CHECK(cache.get("$.books[?twice(@.price) > 20].title")->evaluate(doc) == json::parse(R"(["B"])"));
+    }
+
+    SECTION("json_query and json_replace use the default cache")
+    {
+        auto before = jsonpath::default_expression_cache<json>().stats();
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK(jsonpath::json_query(doc, "$.books[?@.price > 10].title") == json::parse(R"(["B"])"));
+        }
+        auto after = jsonpath::default_expression_cache<json>().stats();
+        CHECK(after.hits - before.hits >= 2);
+
+        json copy = doc;
+        jsonpath::json_replace(copy, "$.books[*].price", 1);
+        jsonpath::json_replace(copy, "$.books[*].price", [](const json& v){return json(v.as<int>() + 1);});
+        CHECK(copy["books"][1]["price"] == json(2));
+    }
+
+    SECTION("concurrent evaluation")
+    {
+        jsonpath::jsonpath_expression_cache<json> cache(4);
+        std::vector<std::thread> threads;
+        std::vector<int> ok(4, 0);
+        for (std::size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (int i = 0; i < 200; ++i)
+                {
+                    std::string path = "$.books[" + std::to_string(i % 6 == 0 ? 0 : 1) + "].title";
+                    auto expr = cache.get(path);
+                    if (expr->evaluate(doc).size() == 1)
+                    {
+                        ++ok[t];
+                    }
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        for (auto n : ok)
+        {
+            CHECK(n == 200);
+        }
+    }
+}
+
+TEST_CASE("jsonpath temporaries")
+{
+    json doc = json::parse(R"([{"a":"first","tags":[1,2]},{"a":"second","tags":[1]},{"a":"third","tags":[]}])");
+    auto& arena = jsoncons::detail::scratch_arena::thread_instance();
+    std::size_t count = arena.object_count();
+
+    SECTION("released after each evaluation")
+    {
+        auto expr = jsonpath::make_expression<json>("$[?(length(@.tags) > 0)].a");
+        for (int i = 0; i < 3; ++i)
+        {
+            json result = expr.evaluate(doc, jsonpath::result_options::path);
+            REQUIRE(result.size() == 2);
+            CHECK(result[0].as<std::string>() == "$[0]['a']");
+            CHECK(result[1].as<std::string>() == "$[1]['a']");
+            CHECK(arena.object_count() == count);
+        }
+    }
+
+    SECTION("nested evaluation from a callback")
+    {
+        auto outer = jsonpath::make_expression<json>("$[*].a");
+        auto inner = jsonpath::make_expression<json>("$..tags[0]");
+        std::vector<std::string> paths;
+        outer.evaluate(doc, [&](const std::string& path, const json&)
+        {
+            paths.push_back(path);
+            json r = inner.evaluate(doc, jsonpath::result_options::path);
+            CHECK(r.size() == 2);
+        }, jsonpath::result_options::path);
+        REQUIRE(paths.size() == 3);
+        CHECK(paths[2] == "$[2]['a']");
+        CHECK(arena.object_count() == count);
+    }
+}
+
+TEST_CASE("jsonpath nodups")
+{
+    json doc = json::parse(R"({"a":[{"b":1},{"b":2}],"c":{"b":3}})");
+
+    SECTION("keeps the first occurrence in the original order")
+    {
+        json result = jsonpath::json_query(doc, "$['c','a','c'][*]", jsonpath::result_options::nodups | jsonpath::result_options::path);
+        REQUIRE(result.size() == 3);
+        CHECK(result[0].as<std::string>() == "$['c']['b']");
+        CHECK(result[1].as<std::string>() == "$['a'][0]");
+        CHECK(result[2].as<std::string>() == "$['a'][1]");
+    }
+
+    SECTION("recursive descent matched twice")
+    {
+        json result = jsonpath::json_query(doc, "$..[*,*]", jsonpath::result_options::nodups | jsonpath::result_options::path);
+        json expected = jsonpath::json_query(doc, "$..*", jsonpath::result_options::nodups | jsonpath::result_options::path);
+        CHECK(result.size() == 7);
+        CHECK(result == expected);
+    }
+}
+
+namespace {
+
+    // An array of n objects, each with a nested array, so that $..* matches about 6n nodes
+    json make_nodups_document(std::size_t n)
+    {
+        json doc(json_array_arg);
+        doc.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            json item(json_object_arg);
+            item.try_emplace("id", i);
+            item.try_emplace("values", json(json_array_arg, {json(i), json(i+1), json(i+2)}));
+            doc.push_back(std::move(item));
+        }
+        return doc;
+    }
+
+} // namespace
+
+TEST_CASE("jsonpath nodups benchmark", "[.benchmark]")
+{
+    for (std::size_t n : {10000, 20000, 40000, 80000})
+    {
+        json doc = make_nodups_document(n);
+        auto expr = jsonpath::make_expression<json>("$..*");
+
+        auto start = std::chrono::high_resolution_clock::now();
+        json plain = expr.evaluate(doc);
+        auto plain_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        json nodups = expr.evaluate(doc, jsonpath::result_options::nodups);
+        auto nodups_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        json sorted = expr.evaluate(doc, jsonpath::result_options::nodups | jsonpath::result_options::sort);
+        auto sorted_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        CHECK(nodups.size() == plain.size());
+        CHECK(sorted.size() == plain.size());
+        std::cout << "$..* over " << plain.size() << " nodes: " 
+                  << plain_time.count() << "ms, nodups " << nodups_time.count() << "ms, nodups|sort " 
+                  << sorted_time.count() << "ms\n";
+    }
+}
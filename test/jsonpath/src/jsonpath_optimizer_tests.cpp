@@ -0,0 +1,153 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string store = R"(
+{
+    "store": {
+        "book": [
+            {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+            {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+            {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99},
+            {"category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings", "isbn": "0-395-19395-8", "price": 22.99}
+        ],
+        "bicycle": {"color": "red", "price": 19.95}
+    }
+}
+)";
+
+    // The streaming expression evaluates paths without the optimizer, so the optimized
+    // plan must give the same values and paths
+    void check_against_streaming(const std::string& path)
+    {
+        ojson doc = ojson::parse(store);
+        ojson values = jsonpath::json_query(doc, path);
+        ojson paths = jsonpath::json_query(doc, path, jsonpath::result_options::path);
+
+        auto expr = jsonpath::make_streaming_expression<ojson>(path);
+        json_string_cursor cursor(store);
+        std::vector<std::string> expected_paths;
+        ojson expected_values(json_array_arg);
+        expr.evaluate(cursor, [&](const std::string& p, const ojson& val)
+        {
+            expected_paths.push_back(p);
+            expected_values.push_back(val);
+        });
+
+        INFO(path);
+        REQUIRE(values.size() == expected_values.size());
+        REQUIRE(paths.size() == expected_paths.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(values[i] == expected_values[i]);
+            CHECK(paths[i].as<std::string>() == expected_paths[i]);
+        }
+    }
+
+} // namespace
+
+TEST_CASE("jsonpath optimizer tests")
+{
+    SECTION("optimized plans agree with streaming evaluation")
+    {
+        check_against_streaming("$.store.bicycle.color");
+        check_against_streaming("$['store']['book'][1]['title']");
+        check_against_streaming("$.store.book[*].author");
+        check_against_streaming("$..price");
+        check_against_streaming("$..book[2].title");
+        check_against_streaming("$..bicycle.color");
+        check_against_streaming("$.store..price");
+        check_against_streaming("$.store.nothing.here");
+        check_against_streaming("$.store.book[?(@.price < 5 + 5)].title");
+        check_against_streaming("$.store.book[?(@.price > -(-10))].title");
+    }
+
+    SECTION("recursive descent to a name")
+    {
+        json doc = json::parse(R"({"a":{"a":{"b":1,"a":[10,20]}},"c":[{"a":true},"a"]})");
+
+        json paths = jsonpath::json_query(doc, "$..a", jsonpath::result_options::path);
+        json expected = json::parse(R"(["$['a']","$['a']['a']","$['a']['a']['a']","$['c'][0]['a']"])");
+        CHECK(paths == expected);
+
+        json values = jsonpath::json_query(doc, "$..a[1]");
+        CHECK(values == json::parse("[20]"));
+
+        json lengths = jsonpath::json_query(doc, "$..length");
+        CHECK(lengths == json::parse("[2,2]"));
+
+        json indexed = jsonpath::json_query(doc, "$..1", jsonpath::result_options::path);
+        CHECK(indexed == json::parse(R"(["$['a']['a']['a'][1]","$['c'][1]"])"));
+    }
+
+    SECTION("paths fused into one lookup")
+    {
+        json doc = json::parse(R"({"a":{"b":{"c":"hello","d":[1,2,3]}}})");
+
+        CHECK(jsonpath::json_query(doc, "$.a.b.c") == json::parse(R"(["hello"])"));
+        CHECK(jsonpath::json_query(doc, "$.a.b.c.length") == json::parse("[5]"));
+        CHECK(jsonpath::json_query(doc, "$.a.b.d.2") == json::parse("[3]"));
+        CHECK(jsonpath::json_query(doc, "$.a.x.c").empty());
+        CHECK(jsonpath::json_query(doc, "$.a.b.c", jsonpath::result_options::path) == json::parse(R"(["$['a']['b']['c']"])"));
+        CHECK(jsonpath::json_query(doc, "$[?(@.b.d.length == 3)].b.c") == json::parse(R"(["hello"])"));
+        CHECK(jsonpath::json_query(doc, "$.a.b.c^") == json::parse(R"([{"c":"hello","d":[1,2,3]}])"));
+    }
+
+    SECTION("plan")
+    {
+        auto expr = jsonpath::make_expression<json>("$.store.book[?(@.price < 5 + 5)].title");
+        std::string plan = expr.to_string();
+        CHECK(plan.find("identifier path selector store book") != std::string::npos);
+        CHECK(plan.find("10") != std::string::npos);
+        CHECK(plan.find("plus") == std::string::npos);
+
+        auto expr2 = jsonpath::make_expression<json>("$..author");
+        CHECK(expr2.to_string().find("recursive identifier selector author") != std::string::npos);
+
+        auto expr3 = jsonpath::make_expression<json>("$..*");
+        CHECK(expr3.to_string().find("recursive selector") != std::string::npos);
+    }
+
+    SECTION("first")
+    {
+        json doc = json::parse(store);
+
+        // json sorts member names, so the bicycle is found before the books
+        json result = jsonpath::json_query(doc, "$..price", jsonpath::result_options::first);
+        CHECK(result == json::parse("[19.95]"));
+
+        result = jsonpath::json_query(doc, "$..price", jsonpath::result_options::first | jsonpath::result_options::path);
+        CHECK(result == json::parse(R"(["$['store']['bicycle']['price']"])"));
+
+        result = jsonpath::json_query(doc, "$.store.book[*].price", jsonpath::result_options::first | jsonpath::result_options::sort);
+        CHECK(result == json::parse("[8.95]"));
+
+        result = jsonpath::json_query(doc, "$..*", jsonpath::result_options::first | jsonpath::result_options::sort);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == doc["store"]);
+
+        result = jsonpath::json_query(doc, "$.store.book[?(@.price > 10)].title", jsonpath::result_options::first | jsonpath::result_options::nodups);
+        CHECK(result == json::parse(R"(["Sword of Honour"])"));
+
+        result = jsonpath::json_query(doc, "$.store.nothing", jsonpath::result_options::first);
+        CHECK(result.empty());
+
+        std::size_t count = 0;
+        auto expr = jsonpath::make_expression<json>("$..book[*]");
+        expr.evaluate(doc, [&](const std::string&, const json&){++count;}, jsonpath::result_options::first);
+        CHECK(count == 1);
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <catch/catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_items(std::size_t count)
+    {
+        json items(json_array_arg);
+        items.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json item(json_object_arg);
+            item.try_emplace("id", i);
+            item.try_emplace("price", (i % 97) * 1.5);
+            item.try_emplace("tags", json::parse(R"(["a","b"])"));
+            if (i % 10 == 0)
+            {
+                item.try_emplace("name", "item" + std::to_string(i));
+            }
+            items.push_back(std::move(item));
+        }
+        json doc(json_object_arg);
+        doc.try_emplace("items", std::move(items));
+        return doc;
+    }
+
+    void check_same_as_sequential(const json& doc, const std::string& path, jsonpath::result_options options)
+    {
+        INFO(path);
+        json expected = jsonpath::json_query(doc, path, options);
+        json result = jsonpath::json_query(doc, path, options | jsonpath::result_options::parallel);
+        CHECK(result == expected);
+    }
+
+} // namespace
+
+TEST_CASE("jsonpath parallel evaluation")
+{
+    json doc = make_items(10000);
+
+    SECTION("same results, in the same order")
+    {
+        const char* paths[] = {
+            "$.items[?(@.price > 100)].id",
+            "$.items[*].id",
+            "$.items[*].tags[1]",
+            "$..name",
+            "$..tags[0]",
+            "$..[?(@.id == 9999)]",
+            "$.items[?(@.price < 3 && @.name)].name.length",
+            "$.items[?(@.price == $.items[3].price)].id"
+        };
+        for (auto path : paths)
+        {
+            check_same_as_sequential(doc, path, jsonpath::result_options());
+            check_same_as_sequential(doc, path, jsonpath::result_options::path);
+            check_same_as_sequential(doc, path, jsonpath::result_options::sort | jsonpath::result_options::nodups);
+        }
+        json result = jsonpath::json_query(doc, "$.items[?(@.price > 100)].id", jsonpath::result_options::parallel);
+        CHECK(result.size() == 3090);
+    }
+
+    SECTION("callback on the calling thread, in document order")
+    {
+        std::size_t count = 0;
+        bool in_order = true;
+        std::size_t last = 0;
+        auto expr = jsonpath::make_expression<json>("$.items[?(@.id % 2 == 0)].id");
+        expr.evaluate(doc, [&](const std::string&, const json& val)
+        {
+            std::size_t id = val.as<std::size_t>();
+            in_order = in_order && (count == 0 || id > last);
+            last = id;
+            ++count;
+        }, jsonpath::result_options::parallel);
+        CHECK(count == 5000);
+        CHECK(in_order);
+    }
+
+    SECTION("first")
+    {
+        json result = jsonpath::json_query(doc, "$.items[?(@.id > 5000)].id",
+                                           jsonpath::result_options::parallel | jsonpath::result_options::first);
+        CHECK(result == json::parse("[5001]"));
+    }
+
+    SECTION("replace")
+    {
+        json expected = doc;
+        jsonpath::json_replace(expected, "$.items[?(@.price > 100)].price",
+                               [](const std::string&, json& price){price = price.as<double>() * 2;});
+        json result = doc;
+        jsonpath::json_replace(result, "$.items[?(@.price > 100)].price",
+                               [](const std::string&, json& price){price = price.as<double>() * 2;},
+                               jsonpath::result_options::nodups | jsonpath::result_options::parallel);
+        CHECK(result == expected);
+    }
+}
+
+TEST_CASE("jsonpath parallel benchmark", "[.benchmark]")
+{
+    json doc = make_items(1000000);
+    auto expr = jsonpath::make_expression<json>("$.items[?(@.price > 100 && @.tags[1] == 'b')].id");
+
+    for (auto options : {jsonpath::result_options(), jsonpath::result_options::parallel})
+    {
+        auto start = std::chrono::steady_clock::now();
+        json result = expr.evaluate(doc, options);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << (options == jsonpath::result_options::parallel ? "parallel:   " : "sequential: ")
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                  << result.size() << " results\n";
+    }
+}
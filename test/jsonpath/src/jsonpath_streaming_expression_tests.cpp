@@ -0,0 +1,151 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string store = R"(
+{
+    "store": {
+        "book": [
+            {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+            {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+            {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99},
+            {"category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings", "isbn": "0-395-19395-8", "price": 22.99}
+        ],
+        "bicycle": {"color": "red", "price": 19.95}
+    }
+}
+)";
+
+    // Streamed results, with paths, must agree with json_query on the whole document,
+    // ojson so that json_query also reports members in document order
+    void check_against_json_query(const std::string& path)
+    {
+        ojson doc = ojson::parse(store);
+        ojson expected_values = jsonpath::json_query(doc, path);
+        ojson expected_paths = jsonpath::json_query(doc, path, jsonpath::result_options::path);
+
+        auto expr = jsonpath::make_streaming_expression<ojson>(path);
+        json_string_cursor cursor(store);
+        std::vector<std::string> paths;
+        ojson values(json_array_arg);
+        expr.evaluate(cursor, [&](const std::string& p, const ojson& val)
+        {
+            paths.push_back(p);
+            values.push_back(val);
+        });
+
+        INFO(path);
+        REQUIRE(values.size() == expected_values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(values[i] == expected_values[i]);
+            CHECK(paths[i] == expected_paths[i].as<std::string>());
+        }
+    }
+
+} // namespace
+
+TEST_CASE("jsonpath streaming_expression tests")
+{
+    SECTION("agrees with json_query")
+    {
+        check_against_json_query("$.store.book[*].author");
+        check_against_json_query("$['store']['bicycle']");
+        check_against_json_query("$.store.book[1,3].title");
+        check_against_json_query("$.store.book[1:].price");
+        check_against_json_query("$.store.book[0:4:2].title");
+        check_against_json_query("$.store.*");
+        check_against_json_query("$..price");
+        check_against_json_query("$..book[2]");
+        check_against_json_query("$.store.book[?(@.price < 10)].title");
+        check_against_json_query("$..book[?(@.isbn)]");
+        check_against_json_query("$.store.book[?(@.author == 'Evelyn Waugh' || @.title =~ /Moby.*/)].price");
+        check_against_json_query("$.store.book[?(@.author =~ /^J.*s$/)].title");
+        check_against_json_query("$.nothing.here");
+    }
+
+    SECTION("root")
+    {
+        auto expr = jsonpath::make_streaming_expression<json>("$");
+        json_string_cursor cursor(store);
+        json result = expr.evaluate(cursor);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0] == json::parse(store));
+    }
+
+    SECTION("cbor cursor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json::parse(store), data);
+
+        auto expr = jsonpath::make_streaming_expression<json>("$.store.book[?(@.price > 10)].author");
+        cbor::cbor_bytes_cursor cursor(data);
+        json result = expr.evaluate(cursor);
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].as<std::string>() == "Evelyn Waugh");
+        CHECK(result[1].as<std::string>() == "J. R. R. Tolkien");
+    }
+
+    SECTION("matches under a match are reported once each")
+    {
+        std::string input = R"({"a":{"a":{"a":1}}})";
+        auto expr = jsonpath::make_streaming_expression<json>("$..a");
+        json_string_cursor cursor(input);
+        std::vector<std::string> paths;
+        expr.evaluate(cursor, [&](const std::string& p, const json&){paths.push_back(p);});
+        REQUIRE(paths.size() == 3);
+        CHECK(paths[0] == "$['a']");
+        CHECK(paths[1] == "$['a']['a']");
+        CHECK(paths[2] == "$['a']['a']['a']");
+    }
+
+    SECTION("quoted names")
+    {
+        std::string input = R"({"a b":{"it's":true}})";
+        auto expr = jsonpath::make_streaming_expression<json>(R"($['a b']["it's"])");
+        json_string_cursor cursor(input);
+        json result = expr.evaluate(cursor);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].as<bool>());
+    }
+
+    SECTION("paths that are not forward only")
+    {
+        std::error_code ec;
+        jsonpath::make_streaming_expression<json>("$.store.book[-1]", ec);
+        CHECK(ec == jsonpath::jsonpath_errc::expected_forward_only_path);
+
+        ec = std::error_code();
+        jsonpath::make_streaming_expression<json>("$.store.book[-2:]", ec);
+        CHECK(ec == jsonpath::jsonpath_errc::expected_forward_only_path);
+
+        ec = std::error_code();
+        jsonpath::make_streaming_expression<json>("$.store.book[?(@.price < $.limit)]", ec);
+        CHECK(ec == jsonpath::jsonpath_errc::expected_forward_only_path);
+
+        ec = std::error_code();
+        jsonpath::make_streaming_expression<json>("$.store.book[0].^", ec);
+        CHECK(ec == jsonpath::jsonpath_errc::expected_forward_only_path);
+
+        // '$' inside a string literal is fine
+        ec = std::error_code();
+        jsonpath::make_streaming_expression<json>("$.store.book[?(@.price == '$1')]", ec);
+        CHECK_FALSE(ec);
+
+        CHECK_THROWS_AS(jsonpath::make_streaming_expression<json>("$.store.book[-1]"), jsonpath::jsonpath_error);
+    }
+}
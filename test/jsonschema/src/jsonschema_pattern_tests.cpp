@@ -0,0 +1,144 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#include <jsoncons_ext/jsonschema/jsonschema.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <catch/catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using jsoncons::json;
+namespace jsonschema = jsoncons::jsonschema;
+namespace jsonpath = jsoncons::jsonpath;
+
+namespace {
+
+    const std::string schema_text = R"(
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "type": "object",
+  "properties": {
+    "email": {"type": "string", "pattern": "^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$"},
+    "phone": {"type": "string", "pattern": "^(\\([0-9]{3}\\))?[0-9]{3}-[0-9]{4}$"},
+    "date": {"type": "string", "pattern": "^\\d{4}-\\d{2}-\\d{2}$"},
+    "word": {"type": "string", "pattern": "\\bcat\\b"},
+    "filter": {"type": "string", "format": "regex"}
+  },
+  "patternProperties": {
+    "^x-": {"type": "string"},
+    "^[0-9]+$": {"type": "integer"}
+  },
+  "additionalProperties": false
+}
+    )";
+
+    json make_people(std::size_t count)
+    {
+        json people(jsoncons::json_array_arg);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json person(jsoncons::json_object_arg);
+            person.try_emplace("email", "user" + std::to_string(i) + (i % 7 == 0 ? "@bad" : "@example.com"));
+            person.try_emplace("phone", "(416)555-" + std::to_string(1000 + i % 9000));
+            person.try_emplace("date", "2021-10-" + std::to_string(10 + i % 20));
+            person.try_emplace("x-source", "import");
+            people.push_back(std::move(person));
+        }
+        return people;
+    }
+
+} // namespace
+
+TEST_CASE("jsonschema patterns")
+{
+    json schema = json::parse(schema_text);
+    auto sch = jsonschema::make_schema(schema);
+    jsonschema::json_validator<json> validator(sch);
+
+    SECTION("pattern")
+    {
+        CHECK(validator.is_valid(json::parse(R"({"email":"bob@example.com","phone":"(416)555-1234","date":"2021-10-17"})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"email":"bob@example"})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"phone":"555-12345"})")));
+        CHECK(validator.is_valid(json::parse(R"({"word":"a cat sat"})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"word":"concatenate"})")));
+    }
+
+    SECTION("patternProperties")
+    {
+        CHECK(validator.is_valid(json::parse(R"({"x-a":"b","42":1})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"x-a":1})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"42":"1"})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"y-a":"b"})")));
+    }
+
+    SECTION("format regex")
+    {
+        CHECK(validator.is_valid(json::parse(R"({"filter":"^a+(b|c)$"})")));
+        CHECK_FALSE(validator.is_valid(json::parse(R"({"filter":"^a+(b|c$"})")));
+    }
+
+    SECTION("same results with std::regex")
+    {
+        json people = make_people(200);
+        std::size_t valid = 0;
+        for (const auto& person : people.array_range())
+        {
+            valid += validator.is_valid(person) ? 1 : 0;
+        }
+
+        jsoncons::set_regex_engine<char>(std::make_shared<jsoncons::std_regex_engine<char>>());
+        auto sch2 = jsonschema::make_schema(schema);
+        jsonschema::json_validator<json> std_validator(sch2);
+        std::size_t std_valid = 0;
+        for (const auto& person : people.array_range())
+        {
+            std_valid += std_validator.is_valid(person) ? 1 : 0;
+        }
+        jsoncons::set_regex_engine<char>(nullptr);
+
+        CHECK(valid == 171);
+        CHECK(std_valid == valid);
+    }
+}
+
+TEST_CASE("jsonschema and jsonpath pattern benchmark", "[.benchmark]")
+{
+    json schema = json::parse(schema_text);
+    json people = make_people(20000);
+
+    std::shared_ptr<const jsoncons::regex_engine> engines[] = {
+        std::make_shared<jsoncons::std_regex_engine<char>>(),
+        std::make_shared<jsoncons::default_regex_engine<char>>()
+    };
+    for (auto& engine : engines)
+    {
+        jsoncons::set_regex_engine<char>(engine);
+        const char* name = engine == engines[0] ? "std::regex" : "default";
+
+        auto sch = jsonschema::make_schema(schema);
+        jsonschema::json_validator<json> validator(sch);
+        std::size_t valid = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& person : people.array_range())
+        {
+            valid += validator.is_valid(person) ? 1 : 0;
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << name << " schema: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                  << valid << " valid\n";
+
+        auto expr = jsonpath::make_expression<json>("$[?(@.email =~ /^[a-z]+[0-9]*@example\\.com$/ && @.phone =~ /^\\(416\\)/)].date");
+        start = std::chrono::steady_clock::now();
+        json result = expr.evaluate(people);
+        end = std::chrono::steady_clock::now();
+        std::cout << name << " filter: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                  << result.size() << " results\n";
+    }
+    jsoncons::set_regex_engine<char>(nullptr);
+}
@@ -0,0 +1,91 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/scratch_arena.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct counted
+    {
+        static int live;
+        std::string s;
+
+        explicit counted(const std::string& s)
+            : s(s)
+        {
+            ++live;
+        }
+        ~counted()
+        {
+            --live;
+        }
+    };
+
+    int counted::live = 0;
+
+} // namespace
+
+TEST_CASE("detail::scratch_arena tests")
+{
+    jsoncons::detail::scratch_arena arena;
+
+    SECTION("rewind destroys the objects created after the mark")
+    {
+        auto m0 = arena.mark();
+        counted* a = arena.create<counted>("a string that is too long for the small string buffer");
+        auto m1 = arena.mark();
+        arena.create<counted>("b");
+        arena.create<counted>("c");
+        CHECK(counted::live == 3);
+        CHECK(arena.object_count() == 3);
+
+        arena.rewind(m1);
+        CHECK(counted::live == 1);
+        CHECK(a->s == "a string that is too long for the small string buffer");
+
+        arena.rewind(m0);
+        CHECK(counted::live == 0);
+        CHECK(arena.object_count() == 0);
+    }
+
+    SECTION("blocks are reused after a rewind")
+    {
+        auto m = arena.mark();
+        for (int i = 0; i < 1000; ++i)
+        {
+            arena.create<json>(json_array_arg);
+        }
+        std::size_t blocks = arena.block_count();
+        CHECK(blocks > 1);
+        CHECK(blocks < 1000);
+        arena.rewind(m);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            arena.create<json>(json_array_arg);
+        }
+        CHECK(arena.block_count() == blocks);
+        arena.rewind(m);
+    }
+
+    SECTION("trivially destructible and over aligned objects")
+    {
+        auto m = arena.mark();
+        for (int i = 0; i < 100; ++i)
+        {
+            char* c = arena.create<char>('x');
+            CHECK(*c == 'x');
+            double* d = arena.create<double>(1.5);
+            CHECK(reinterpret_cast<std::uintptr_t>(d) % alignof(double) == 0);
+            json* j = arena.create<json>("a string");
+            CHECK(reinterpret_cast<std::uintptr_t>(j) % alignof(json) == 0);
+        }
+        arena.rewind(m);
+        CHECK(arena.object_count() == 0);
+    }
+}
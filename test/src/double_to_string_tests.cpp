@@ -8,6 +8,8 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <cstring>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -168,3 +170,81 @@ TEST_CASE("test_double_to_wstring")
 }
 
 
+
+TEST_CASE("test_double_to_string shortest")
+{
+    auto to_shortest = [](double val) -> std::string
+    {
+        jsoncons::detail::write_double print(float_chars_format::shortest, 0);
+        std::string s;
+        jsoncons::string_sink<std::string> writer(s);
+        print(val, writer);
+        writer.flush();
+        return s;
+    };
+
+    SECTION("values grisu3 cannot print")
+    {
+        CHECK(to_shortest(1e23) == std::string("1e+23"));
+        CHECK(to_shortest(53165205877497296.0) == std::string("53165205877497300.0"));
+        CHECK(to_shortest(8.6027379396816665e+79) == std::string("8.602737939681667e+79"));
+        CHECK(to_shortest(-4.6748272773403566e-65) == std::string("-4.6748272773403566e-65"));
+    }
+
+    SECTION("same layout as general")
+    {
+        CHECK(to_shortest(0.0) == std::string("0.0"));
+        CHECK(to_shortest(-0.0) == std::string("0.0"));
+        CHECK(to_shortest(1.0) == std::string("1.0"));
+        CHECK(to_shortest(-10.0) == std::string("-10.0"));
+        CHECK(to_shortest(0.1) == std::string("0.1"));
+        CHECK(to_shortest(0.0001) == std::string("0.0001"));
+        CHECK(to_shortest(1e-5) == std::string("1e-05"));
+        CHECK(to_shortest(5e-324) == std::string("5e-324"));
+        CHECK(to_shortest(1.7976931348623157e308) == std::string("1.7976931348623157e+308"));
+    }
+
+    SECTION("random round trip")
+    {
+        std::mt19937_64 rng(20210705);
+        jsoncons::detail::chars_to to_double;
+        for (std::size_t i = 0; i < 100000; ++i)
+        {
+            uint64_t bits = rng();
+            double val;
+            std::memcpy(&val, &bits, sizeof(double));
+            if (!std::isfinite(val))
+            {
+                continue;
+            }
+            std::string s = to_shortest(val);
+            CHECK(to_double(s.c_str(), s.length()) == val);
+
+            char buffer[32];
+            int length;
+            int k;
+            double u = std::signbit(val) ? -val : val;
+            if (val != 0 && jsoncons::detail::grisu3(u, buffer, &length, &k))
+            {
+                std::string expected;
+                if (std::signbit(val))
+                {
+                    expected.push_back('-');
+                }
+                jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, expected);
+                CHECK(s == expected);
+            }
+        }
+    }
+
+    SECTION("encoder option")
+    {
+        json j(json_array_arg, {1e23, 0.5});
+        auto options = json_options{}.float_format(float_chars_format::shortest);
+        CHECK(j.to_string(options) == std::string("[1e+23,0.5]"));
+
+        std::string s;
+        j.dump(s, options);
+        CHECK(s == std::string("[1e+23,0.5]"));
+    }
+}
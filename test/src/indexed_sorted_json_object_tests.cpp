@@ -0,0 +1,98 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <map>
+#include <vector>
+#include <iterator>
+#include "random_object_operations.hpp"
+
+using namespace jsoncons;
+
+using ijson = basic_json<char,indexed_sorted_policy,std::allocator<char>>;
+
+namespace {
+
+    // Members sorted by key, the try_emplace hint makes no difference
+    class sorted_model
+    {
+        std::map<std::string,int> items_;
+    public:
+        std::size_t size() const
+        {
+            return items_.size();
+        }
+
+        std::vector<std::pair<std::string,int>> items() const
+        {
+            return std::vector<std::pair<std::string,int>>(items_.begin(), items_.end());
+        }
+
+        void insert_or_assign(const std::string& key, int value)
+        {
+            items_[key] = value;
+        }
+
+        void try_emplace(std::size_t, const std::string& key, int value)
+        {
+            items_.emplace(key, value);
+        }
+
+        void erase(const std::string& key)
+        {
+            items_.erase(key);
+        }
+
+        void erase(std::size_t first, std::size_t last)
+        {
+            auto it = items_.begin();
+            std::advance(it, first);
+            auto end = it;
+            std::advance(end, last - first);
+            items_.erase(it, end);
+        }
+    };
+
+} // namespace
+
+TEST_CASE("indexed sorted index consistency")
+{
+    check_random_object_operations<ijson,sorted_model>(20210715);
+}
+
+TEST_CASE("indexed sorted json")
+{
+    std::string input = "{";
+    for (int i = 99; i >= 0; --i)
+    {
+        input.append("\"key" + std::to_string(i) + "\":" + std::to_string(i));
+        input.push_back(i > 0 ? ',' : '}');
+    }
+
+    ijson j = ijson::parse(input);
+    json expected = json::parse(input);
+
+    CHECK(j.size() == 100);
+    CHECK(j.to_string() == expected.to_string());
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string key = "key" + std::to_string(i);
+        CHECK(j.contains(key));
+        CHECK(j.at(key).as<int>() == i);
+    }
+    CHECK_FALSE(j.contains("key100"));
+
+    j.erase("key50");
+    j["key100"] = 100;
+    j.merge(ijson::parse(R"({"key1":-1,"key101":101})"));
+
+    CHECK_FALSE(j.contains("key50"));
+    CHECK(j.at("key100").as<int>() == 100);
+    CHECK(j.at("key101").as<int>() == 101);
+    CHECK(j.at("key1").as<int>() == 1);
+    CHECK(j.size() == 101);
+    CHECK(j == ijson::parse(j.to_string()));
+    CHECK_FALSE(j < ijson::parse(j.to_string()));
+}
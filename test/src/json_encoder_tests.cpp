@@ -115,3 +115,41 @@ TEMPLATE_TEST_CASE("test_json_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.string2() == R"(["foo",42])");
 }
+
+TEST_CASE("json_encoder escape long strings")
+{
+    // Characters that need escaping at every offset within and across 16 and 32 byte runs
+    for (std::size_t offset = 0; offset < 70; ++offset)
+    {
+        std::string prefix(offset, 'a');
+        std::string suffix(offset, 'b');
+
+        // quote, backslash and control characters
+        {
+            std::string s = prefix + "\"\\\n\x01\x7F/" + suffix;
+            std::string expected = "\"" + prefix + "\\\"\\\\\\n\\u0001\\u007F/" + suffix + "\"";
+            std::string buffer;
+            encode_json(json(s), buffer);
+            CHECK(buffer == expected);
+        }
+        // escape_solidus
+        {
+            std::string s = prefix + "/" + suffix;
+            std::string expected = "\"" + prefix + "\\/" + suffix + "\"";
+            std::string buffer;
+            encode_json(json(s), buffer, json_options{}.escape_solidus(true));
+            CHECK(buffer == expected);
+        }
+        // non-ascii
+        {
+            std::string s = prefix + "\xE2\x82\xAC" + suffix;
+            std::string buffer1;
+            encode_json(json(s), buffer1);
+            CHECK(buffer1 == "\"" + s + "\"");
+
+            std::string buffer2;
+            encode_json(json(s), buffer2, json_options{}.escape_all_non_ascii(true));
+            CHECK(buffer2 == "\"" + prefix + "\\u20AC" + suffix + "\"");
+        }
+    }
+}
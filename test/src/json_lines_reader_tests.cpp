@@ -0,0 +1,126 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t count)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            s += R"({"id":)" + std::to_string(i) + R"(,"name":"item )" + std::to_string(i) + R"(","tags":["a","b"]})";
+            s += (i % 7 == 0) ? "\r\n" : "\n";
+            if (i % 11 == 0)
+            {
+                s += "  \n";
+            }
+        }
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("json_lines_reader tests")
+{
+    std::string input = make_lines(500);
+
+    std::vector<json> expected;
+    std::vector<std::size_t> expected_lines;
+    {
+        std::istringstream is(input);
+        std::string line;
+        std::size_t n = 0;
+        while (std::getline(is, line))
+        {
+            ++n;
+            if (line.find('{') != std::string::npos)
+            {
+                expected.push_back(json::parse(line));
+                expected_lines.push_back(n);
+            }
+        }
+    }
+
+    SECTION("ordered")
+    {
+        for (std::size_t threads : {1, 2, 4})
+        {
+            std::istringstream is(input);
+            json_lines_reader<json> reader(is, json_lines_options().thread_count(threads).chunk_size(256).max_queue_depth(3));
+
+            std::vector<json> docs;
+            std::vector<std::size_t> lines;
+            reader.read([&](json&& j, std::size_t line){docs.push_back(std::move(j)); lines.push_back(line);});
+            CHECK(docs == expected);
+            CHECK(lines == expected_lines);
+        }
+    }
+
+    SECTION("unordered")
+    {
+        std::istringstream is(input);
+        json_lines_reader<json> reader(is, json_lines_options().thread_count(4).chunk_size(100).ordered(false));
+
+        std::vector<std::pair<std::size_t,json>> docs;
+        reader.read([&](json&& j, std::size_t line){docs.emplace_back(line, std::move(j));});
+        REQUIRE(docs.size() == expected.size());
+        std::sort(docs.begin(), docs.end(), 
+                  [](const std::pair<std::size_t,json>& a, const std::pair<std::size_t,json>& b){return a.first < b.first;});
+        for (std::size_t i = 0; i < docs.size(); ++i)
+        {
+            CHECK(docs[i].first == expected_lines[i]);
+            CHECK(docs[i].second == expected[i]);
+        }
+    }
+
+    SECTION("visitor")
+    {
+        std::string text = "[1,2]\n{\"a\":true}\n\"s\"";
+        json_lines_reader<json,string_source<char>> reader(text, json_lines_options().thread_count(2));
+
+        json_decoder<json> decoder;
+        reader.read(decoder);
+        // each document replaces the last
+        CHECK(decoder.get_result().as<std::string>() == "s");
+    }
+
+    SECTION("parse error reports the line")
+    {
+        std::string text = make_lines(50) + "{\"id\":}\n" + make_lines(50);
+        std::size_t bad_line = std::count(text.begin(), text.begin() + text.find("{\"id\":}"), '\n') + 1;
+
+        std::istringstream is(text);
+        json_lines_reader<json> reader(is, json_lines_options().thread_count(3).chunk_size(64));
+        std::size_t count = 0;
+        try
+        {
+            reader.read([&](json&&, std::size_t){++count;});
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.line() == bad_line);
+            CHECK(count == 50);
+        }
+    }
+
+    SECTION("exception from the callback")
+    {
+        std::istringstream is(input);
+        json_lines_reader<json> reader(is, json_lines_options().thread_count(2).chunk_size(64));
+        std::size_t count = 0;
+        CHECK_THROWS_AS(reader.read([&](json&&, std::size_t){if (++count == 10) throw std::runtime_error("stop");}), 
+                        std::runtime_error);
+        CHECK(count == 10);
+    }
+}
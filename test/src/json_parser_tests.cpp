@@ -338,3 +338,124 @@ TEST_CASE("test_diagnostics_visitor", "")
         CHECK(os.str() == expected.str());
     }
 }
+
+namespace {
+
+    class position_recorder : public default_json_visitor
+    {
+    public:
+        std::vector<std::string> events;
+    private:
+        void record(const std::string& name, const ser_context& context)
+        {
+            events.push_back(name + "@" + std::to_string(context.line()) + ":" + std::to_string(context.column()) + 
+                             ":" + std::to_string(context.position()));
+        }
+
+        bool visit_begin_object(semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record("begin_object", context);
+            return true;
+        }
+        bool visit_end_object(const ser_context& context, std::error_code&) override
+        {
+            record("end_object", context);
+            return true;
+        }
+        bool visit_begin_array(semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record("begin_array", context);
+            return true;
+        }
+        bool visit_end_array(const ser_context& context, std::error_code&) override
+        {
+            record("end_array", context);
+            return true;
+        }
+        bool visit_key(const string_view_type& s, const ser_context& context, std::error_code&) override
+        {
+            record("key:" + std::string(s), context);
+            return true;
+        }
+        bool visit_string(const string_view_type& s, semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record("string:" + std::string(s), context);
+            return true;
+        }
+        bool visit_uint64(uint64_t val, semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record("uint64:" + std::to_string(val), context);
+            return true;
+        }
+        bool visit_bool(bool val, semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record(val ? "true" : "false", context);
+            return true;
+        }
+        bool visit_null(semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            record("null", context);
+            return true;
+        }
+    };
+
+    std::vector<std::string> parse_events(const std::string& input, std::size_t chunk_size, std::error_code& ec)
+    {
+        position_recorder visitor;
+        json_parser parser;
+        std::size_t offset = 0;
+        do
+        {
+            std::size_t length = (std::min)(chunk_size, input.size() - offset);
+            parser.update(input.data() + offset, length);
+            offset += length;
+            parser.parse_some(visitor, ec);
+            if (ec)
+            {
+                visitor.events.push_back("error@" + std::to_string(parser.line()) + ":" + std::to_string(parser.column()));
+                return visitor.events;
+            }
+        }
+        while (offset < input.size() && !parser.done());
+        parser.finish_parse(visitor, ec);
+        return visitor.events;
+    }
+
+    // Line, column and position may differ when a token straddles two chunks
+    std::vector<std::string> without_positions(std::vector<std::string> events)
+    {
+        for (auto& event : events)
+        {
+            event.erase(event.rfind('@'));
+        }
+        return events;
+    }
+
+} // namespace
+
+TEST_CASE("json_parser chunked input")
+{
+    std::string long_string(200, 'a');
+    std::vector<std::string> inputs = {
+        R"({"foo":[42,null,true,false],"bar":"baz"})",
+        "{\n    \"first\" : \"" + long_string + "\",\r\n    \"second\"  :\t[ 1 ,\t2 ,   3 ]\n}",
+        "[\"" + long_string + "\\n\\\"\\u00e9" + long_string + "\",\"\\ud83d\\ude00\"," + std::string(100, ' ') + "\"end\"]",
+        "[\n" + std::string(70, ' ') + "\"\xE2\x82\xAC" + long_string + "\"\r\n" + std::string(130, '\t') + "]",
+        "[\"" + long_string + "\x01\"]",
+        "[\"abc\ndef\"]",
+        "{\"a\":1," + std::string(65, ' ') + "]"
+    };
+
+    for (const auto& input : inputs)
+    {
+        std::error_code ec1;
+        auto expected = parse_events(input, input.size(), ec1);
+        for (std::size_t chunk_size : {std::size_t(1), std::size_t(7), std::size_t(64), std::size_t(65)})
+        {
+            std::error_code ec2;
+            auto actual = parse_events(input, chunk_size, ec2);
+            CHECK(ec1 == ec2);
+            CHECK(without_positions(expected) == without_positions(actual));
+        }
+    }
+}
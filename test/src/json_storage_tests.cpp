@@ -31,3 +31,58 @@ TEST_CASE("json storage tests")
     CHECK(json_storage_kind::double_value == var9.storage_kind());
 }
 
+
+TEST_CASE("string_view storage tests")
+{
+    std::string input = R"({"name":"Jane Roe","quote":"say \"hi\"","ids":["a1","1.5"]})";
+
+    SECTION("unescaped values refer into the input")
+    {
+        json j = json::parse(string_view_arg, input);
+
+        CHECK(j["name"].storage_kind() == json_storage_kind::string_view_value);
+        CHECK(j["name"].as_string_view().data() == input.data() + 9);
+        CHECK(j["name"].as<std::string>() == "Jane Roe");
+        CHECK(j["quote"].storage_kind() != json_storage_kind::string_view_value);
+        CHECK(j["quote"].as<std::string>() == "say \"hi\"");
+        CHECK(j["ids"][1].as<double>() == 1.5);
+        CHECK(j == json::parse(input));
+        CHECK(j["name"] == json("Jane Roe"));
+        CHECK(json("Jane Roe") == j["name"]);
+    }
+
+    SECTION("copies refer to the same characters")
+    {
+        json j = json::parse(string_view_arg, input);
+        json copy(j);
+        CHECK(copy["name"].storage_kind() == json_storage_kind::string_view_value);
+        CHECK(copy["name"].as_string_view().data() == j["name"].as_string_view().data());
+        json moved(std::move(copy));
+        CHECK(moved["name"].as_string_view().data() == j["name"].as_string_view().data());
+        json other("Too long to fit in small string");
+        swap(other, moved["name"]);
+        CHECK(other.storage_kind() == json_storage_kind::string_view_value);
+        CHECK(moved["name"].storage_kind() == json_storage_kind::long_string_value);
+    }
+
+    SECTION("deep_copy owns its characters")
+    {
+        json result;
+        {
+            std::string temp(input);
+            json j = json::parse(string_view_arg, temp);
+            result = deep_copy(j);
+        }
+        CHECK(result["name"].storage_kind() != json_storage_kind::string_view_value);
+        CHECK(result["name"].as<std::string>() == "Jane Roe");
+        CHECK(result["ids"][0].as<std::string>() == "a1");
+    }
+
+    SECTION("as_cstring")
+    {
+        json j(string_view_arg, string_view("abc"));
+        CHECK(j.is_string());
+        CHECK(j.as<std::string>() == "abc");
+        CHECK_THROWS(j.as_cstring());
+    }
+}
@@ -9,7 +9,11 @@
 #include <utility>
 #include <ctime>
 #include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
 #include <assert.h>
+#include "random_object_operations.hpp"
 
 using namespace jsoncons;
 
@@ -410,3 +414,226 @@ TEST_CASE("order preserving erase")
     }
 }
   
+
+namespace {
+
+    // Members in insertion order, try_emplace inserts at the hint
+    class order_preserving_model
+    {
+        std::vector<std::pair<std::string,int>> items_;
+    public:
+        std::size_t size() const
+        {
+            return items_.size();
+        }
+
+        const std::vector<std::pair<std::string,int>>& items() const
+        {
+            return items_;
+        }
+
+        void insert_or_assign(const std::string& key, int value)
+        {
+            auto it = find(key);
+            if (it == items_.end())
+            {
+                items_.emplace_back(key, value);
+            }
+            else
+            {
+                it->second = value;
+            }
+        }
+
+        void try_emplace(std::size_t hint, const std::string& key, int value)
+        {
+            if (find(key) == items_.end())
+            {
+                items_.emplace(items_.begin() + hint, key, value);
+            }
+        }
+
+        void erase(const std::string& key)
+        {
+            auto it = find(key);
+            if (it != items_.end())
+            {
+                items_.erase(it);
+            }
+        }
+
+        void erase(std::size_t first, std::size_t last)
+        {
+            items_.erase(items_.begin() + first, items_.begin() + last);
+        }
+    private:
+        std::vector<std::pair<std::string,int>>::iterator find(const std::string& key)
+        {
+            return std::find_if(items_.begin(), items_.end(), 
+                                [&](const std::pair<std::string,int>& item){return item.first == key;});
+        }
+    };
+
+} // namespace
+
+TEST_CASE("order preserving index consistency")
+{
+    check_random_object_operations<ojson,order_preserving_model>(20210712);
+}
+
+TEST_CASE("order preserving insert duplicates with many members")
+{
+    using item_type = std::pair<ojson::key_type,ojson>;
+    std::vector<item_type> items;
+    for (int i = 0; i < 100; ++i)
+    {
+        items.emplace_back(std::to_string(i % 40), i);
+    }
+    typename ojson::object o(items.begin(), items.end());
+    REQUIRE(o.size() == 40);
+    for (int i = 0; i < 40; ++i)
+    {
+        CHECK((o.begin() + i)->key() == std::to_string(i));
+        CHECK(o.find(std::to_string(i))->value().as<int>() == i);
+    }
+}
+
+namespace {
+
+    // order_preserving_json_object as it was before the hash index, a vector of positions 
+    // sorted by key, reduced to the members used by the benchmark
+    class sorted_index_json_object
+    {
+        using string_view_type = ojson::string_view_type;
+        using key_value_type = key_value<std::string,ojson>;
+
+        std::vector<key_value_type> members_;
+        std::vector<std::size_t> index_;
+
+        struct Comp
+        {
+            const std::vector<key_value_type>& members_;
+
+            Comp(const std::vector<key_value_type>& members_)
+                : members_(members_)
+            {
+            }
+
+            bool operator() (std::size_t i, string_view_type k) const { return members_.at(i).key() < k; }
+            bool operator() (string_view_type k, std::size_t i) const { return k < members_.at(i).key(); }
+        };
+    public:
+        using iterator = std::vector<key_value_type>::iterator;
+
+        iterator end()
+        {
+            return members_.end();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            auto p = std::equal_range(index_.begin(),index_.end(), name, 
+                                        Comp(members_));        
+            return p.first == p.second ? members_.end() : members_.begin() + *p.first;
+        }
+
+        template <class... Args>
+        std::pair<iterator,bool> try_emplace(const string_view_type& name, Args&&... args)
+        {
+            auto result = insert_index_entry(name,members_.size());
+            if (result.second)
+            {
+                members_.emplace_back(std::string(name.begin(), name.end()), std::forward<Args>(args)...);
+                auto it = members_.begin() + result.first;
+                return std::make_pair(it,true);
+            }
+            else
+            {
+                auto it = members_.begin() + result.first;
+                return std::make_pair(it,false);
+            }
+        }
+    private:
+        std::pair<std::size_t,bool> insert_index_entry(const string_view_type& key, std::size_t pos)
+        {
+            JSONCONS_ASSERT(pos <= index_.size());
+
+            auto it = std::lower_bound(index_.begin(),index_.end(), key, 
+                                        Comp(members_));        
+
+            if (it == index_.end())
+            {
+                std::size_t count = index_.size() - pos;
+                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
+                {
+                    if (index_[i] >= pos)
+                    {
+                        ++index_[i];
+                        --count;
+                    }
+                }
+                index_.push_back(pos);
+                return std::make_pair(pos,true);
+            }
+            else if (members_.at(*it).key() != key)
+            {
+                std::size_t count = index_.size() - pos;
+                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
+                {
+                    if (index_[i] >= pos)
+                    {
+                        ++index_[i];
+                        --count;
+                    }
+                }
+                auto it2 = index_.insert(it, pos);
+                return std::make_pair(*it2,true);
+            }
+            else
+            {
+                return std::make_pair(*it,false);
+            }
+        }
+    };
+
+    template <class Object>
+    void run_insert_benchmark(const std::string& name, const std::vector<std::string>& keys)
+    {
+        Object o;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& key : keys)
+        {
+            o.try_emplace(key, 1);
+        }
+        auto insert_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::size_t found = 0;
+        for (const auto& key : keys)
+        {
+            found += o.find(key) != o.end() ? 1 : 0;
+        }
+        auto find_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        CHECK(found == keys.size());
+        std::cout << name << ": insert " << keys.size() << " keys " << insert_time.count() << "ms, "
+                  << "find " << keys.size() << " keys " << find_time.count() << "ms\n";
+    }
+
+} // namespace
+
+TEST_CASE("order preserving insert benchmark", "[.benchmark]")
+{
+    const std::size_t n = 100000;
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    std::mt19937_64 rng(1);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys.push_back("id-" + std::to_string(rng()));
+    }
+
+    run_insert_benchmark<sorted_index_json_object>("sorted index", keys);
+    run_insert_benchmark<ojson::object>("hash index", keys);
+}
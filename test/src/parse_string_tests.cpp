@@ -124,3 +124,51 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+TEST_CASE("test_parse_long_strings")
+{
+    // Special characters at every offset within and across 16 and 32 byte runs
+    for (std::size_t offset = 0; offset < 70; ++offset)
+    {
+        // escapes
+        {
+            std::string expected = std::string(offset, 'a') + "\"\\/\n" + std::string(offset, 'b');
+            std::string input = "\"" + std::string(offset, 'a') + "\\\"\\\\\\/\\n" + std::string(offset, 'b') + "\"";
+            json j = json::parse(input);
+            CHECK(j.as<std::string>() == expected);
+        }
+        // non-ascii
+        {
+            std::string expected = std::string(offset, 'a') + "\xE2\x82\xAC" + std::string(offset, 'b');
+            json j = json::parse("\"" + expected + "\"");
+            CHECK(j.as<std::string>() == expected);
+        }
+        // invalid utf8
+        {
+            std::string input = "\"" + std::string(offset, 'a') + "\xE2\x82" + std::string(offset, 'b') + "\"";
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_string_reader reader(input, decoder);
+            reader.read(ec);
+            CHECK(ec);
+        }
+        // control character
+        {
+            std::string input = "\"" + std::string(offset, 'a') + "\x1F" + std::string(offset, 'b') + "\"";
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_string_reader reader(input, decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::illegal_control_character);
+        }
+    }
+}
+
+TEST_CASE("test_parse_escaped_unicode_validation")
+{
+    std::error_code ec;
+    json_decoder<json> decoder;
+    std::string input = "\"" + std::string(40, 'a') + "\\ud800" + "\"";
+    json_string_reader reader(input, decoder);
+    reader.read(ec);
+    CHECK(ec);
+}
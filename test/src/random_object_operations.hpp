@@ -0,0 +1,111 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#ifndef JSONCONS_TEST_RANDOM_OBJECT_OPERATIONS_HPP
+#define JSONCONS_TEST_RANDOM_OBJECT_OPERATIONS_HPP
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+#include <random>
+
+// Applies random operations to an object of Json and to Model, a reference model of the
+// member order, crossing the size at which the hash index is built in both directions,
+// and checks that the members and find agree with the model. Model provides size(), items()
+// (the members in order), insert_or_assign(key,value), try_emplace(hint,key,value),
+// erase(key) and erase(first,last).
+template <class Json, class Model>
+void check_random_object_operations(unsigned seed)
+{
+    using object_type = typename Json::object;
+
+    std::mt19937 rng(seed);
+    object_type o;
+    Model expected;
+
+    auto check_all = [&]()
+    {
+        auto items = expected.items();
+        REQUIRE(o.size() == items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            CHECK((o.begin() + i)->key() == items[i].first);
+            auto it = o.find(items[i].first);
+            REQUIRE(bool(it == o.begin() + i));
+            CHECK(it->value().template as<int>() == items[i].second);
+        }
+        CHECK(bool(o.find("missing") == o.end()));
+    };
+
+    for (int round = 0; round < 3000; ++round)
+    {
+        std::string key = "k" + std::to_string(rng() % 200);
+        switch (rng() % 6)
+        {
+            case 0:
+            case 1:
+                o.insert_or_assign(key, Json(round));
+                expected.insert_or_assign(key, round);
+                break;
+            case 2:
+            {
+                std::size_t hint = expected.size() == 0 ? 0 : rng() % expected.size();
+                o.try_emplace(o.begin() + hint, key, Json(round));
+                expected.try_emplace(hint, key, round);
+                break;
+            }
+            case 3:
+                o.erase(key);
+                expected.erase(key);
+                break;
+            case 4:
+                if (expected.size() > 0 && rng() % 8 == 0)
+                {
+                    std::size_t first = rng() % expected.size();
+                    std::size_t last = first + rng() % (expected.size() - first + 1);
+                    o.erase(o.begin() + first, o.begin() + last);
+                    expected.erase(first, last);
+                }
+                break;
+            case 5:
+                if (rng() % 8 == 0)
+                {
+                    object_type source;
+                    for (int j = 0; j < 10; ++j)
+                    {
+                        source.insert_or_assign("k" + std::to_string(rng() % 200), Json(round));
+                    }
+                    o.merge_or_update(source);
+                    for (const auto& member : source)
+                    {
+                        expected.insert_or_assign(std::string(member.key()), round);
+                    }
+                }
+                break;
+        }
+        if (round % 50 == 0)
+        {
+            check_all();
+        }
+    }
+    check_all();
+
+    SECTION("copy and swap")
+    {
+        auto items = expected.items();
+        object_type copy(o);
+        object_type other;
+        other.swap(o);
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            CHECK(bool(other.find(items[i].first) == other.begin() + i));
+            CHECK(bool(copy.find(items[i].first) == copy.begin() + i));
+        }
+        CHECK(o.empty());
+        CHECK(bool(o.find("k0") == o.end()));
+    }
+}
+
+#endif
@@ -0,0 +1,182 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/regex_engine.hpp>
+#include <catch/catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::vector<std::string> inputs = {
+        "", "a", "A", "ab", "abc", "ABC", "aab", "abab", "b", "ba", "cab", "x", "\n", "\r", "a\nb",
+        "0", "42", "123-4567", "(416)555-1234", "416-555-1234", "2021-10-17", "10/17/2021",
+        "foo", "FOO", "foobar", "barfoo", "foo bar", "  ", "\t", "_id", "x-custom", "x-",
+        "hello@example.com", "not an email", "#fff", "#12ab3C", "\xc3\xa9t\xc3\xa9", "a.b", "a+b", "a{2}",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "[]", "a|b", "$", "^", "\\"
+    };
+
+    void check_against_std(const std::string& pattern, bool icase)
+    {
+        detail::regex_dfa dfa;
+        INFO(pattern);
+        INFO(icase);
+        REQUIRE(dfa.compile(pattern.data(), pattern.size(), icase));
+        std::regex re(pattern, icase ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+        for (const auto& input : inputs)
+        {
+            INFO(input);
+            CHECK(dfa.search(input.data(), input.size()) == std::regex_search(input, re));
+        }
+    }
+
+    class counting_engine : public regex_engine
+    {
+    public:
+        mutable std::size_t count = 0;
+
+        pattern_pointer compile(const std::string& pattern, bool icase) const override
+        {
+            ++count;
+            return std_regex_engine<char>().compile(pattern, icase);
+        }
+    };
+
+} // namespace
+
+TEST_CASE("regex_dfa agrees with std::regex")
+{
+    const char* patterns[] = {
+        "a", "ab", "^a", "a$", "^a$", "^$", "", "b|ab", "^(a|b)+$", "a*", "a+b", "a?b", "^a{2}b",
+        "a{2,}", "^a{1,3}$", "(?:ab){2}", "ab*?", "[abc]", "[^abc]", "[a-c]+$", "^[^a-z]", "[-a]", "[a-]",
+        "\\d", "^\\d+$", "\\D", "\\w+", "^\\W", "\\s", "\\S+", "[\\d.]+", "[^\\s]", "\\.", "a\\+b",
+        "\\{", "\\\\", ".", "^.$", "a.b", "^\\d{3}-\\d{4}$", "^(\\([0-9]{3}\\))?[0-9]{3}-[0-9]{4}$",
+        "^\\d{4}-\\d{2}-\\d{2}$", "^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$",
+        "^#([0-9a-fA-F]{3}|[0-9a-fA-F]{6})$", "^x-", "^_", "foo|bar", "(foo|bar)$", "^(foo)?bar",
+        "\\x41", "\\u0062", "[\\x61-\\x63]", "\xc3\xa9", "^a|b$", "(a|)b", "a\\nb", "[\\n\\r]",
+        "^(a+)+b$", "(a|b)*c", "^[^\\d\\s]+$"
+    };
+    for (auto pattern : patterns)
+    {
+        check_against_std(pattern, false);
+        check_against_std(pattern, true);
+    }
+}
+
+TEST_CASE("regex_dfa leaves patterns outside the subset to another engine")
+{
+    const char* patterns[] = {
+        "(a)\\1", "\\bfoo\\b", "a(?=b)", "a(?!b)", "[[:alpha:]]", "[]a]", "[^]", "\\cJ", "\\u00e9",
+        "[\\d-z]", "a**", "^*", "a{2,1}", "(a", "a)", "[a", "\\", "\\q", "a{1000000}"
+    };
+    for (auto pattern : patterns)
+    {
+        INFO(pattern);
+        detail::regex_dfa dfa;
+        CHECK_FALSE(dfa.compile(pattern, std::char_traits<char>::length(pattern), false));
+    }
+}
+
+TEST_CASE("default_regex_engine")
+{
+    default_regex_engine<char> engine;
+
+    SECTION("supported and unsupported patterns")
+    {
+        CHECK(engine.compile("^\\d+$", false)->search(std::string("123")));
+        CHECK_FALSE(engine.compile("^\\d+$", false)->search(std::string("12a")));
+        CHECK(engine.compile("\\bcat\\b", false)->search(std::string("a cat sat")));
+        CHECK_FALSE(engine.compile("\\bcat\\b", false)->search(std::string("concatenate")));
+        CHECK(engine.compile("HELLO", true)->search(std::string("say hello")));
+    }
+
+    SECTION("invalid patterns")
+    {
+        CHECK_THROWS_AS(engine.compile("(a", false), std::regex_error);
+        CHECK_THROWS_AS(engine.compile("a{2,1}", false), std::regex_error);
+    }
+
+    SECTION("wchar_t")
+    {
+        default_regex_engine<wchar_t> wengine;
+        CHECK(wengine.compile(L"^[a-z]+$", false)->search(std::wstring(L"abc")));
+        CHECK_FALSE(wengine.compile(L"^[a-z]+$", false)->search(std::wstring(L"ab1")));
+    }
+}
+
+TEST_CASE("regex cache and pluggable engine")
+{
+    auto engine = std::make_shared<counting_engine>();
+    set_regex_engine<char>(engine);
+
+    auto p1 = compile_regex(std::string("^[a-z]+-\\d+$"));
+    auto p2 = compile_regex(std::string("^[a-z]+-\\d+$"));
+    auto p3 = compile_regex(std::string("^[a-z]+-\\d+$"), true);
+    CHECK(p1 == p2);
+    CHECK(p1 != p3);
+    CHECK(engine->count == 2);
+    CHECK(p1->search(std::string("abc-12")));
+    CHECK_FALSE(p1->search(std::string("ABC-12")));
+    CHECK(p3->search(std::string("ABC-12")));
+    CHECK(regex_cache_stats<char>().hits >= 1);
+
+    // restores the default engine and empties the cache
+    set_regex_engine<char>(nullptr);
+    auto p4 = compile_regex(std::string("^[a-z]+-\\d+$"));
+    CHECK(p4 != p1);
+    CHECK(engine->count == 2);
+    CHECK(p4->search(std::string("abc-12")));
+}
+
+TEST_CASE("regex engine benchmark", "[.benchmark]")
+{
+    const char* patterns[] = {
+        "^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$",
+        "^(\\([0-9]{3}\\))?[0-9]{3}-[0-9]{4}$",
+        "^\\d{4}-\\d{2}-\\d{2}$",
+        "^x-",
+        "[A-Z][a-z]+ [A-Z][a-z]+"
+    };
+    std::vector<std::string> values;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        values.push_back("user" + std::to_string(i) + "@example.com");
+        values.push_back("(416)555-" + std::to_string(1000 + i));
+        values.push_back("x-header-" + std::to_string(i));
+        values.push_back("The quick brown Fox Jumps over the lazy dog " + std::to_string(i));
+    }
+
+    std_regex_engine<char> std_engine;
+    default_regex_engine<char> default_engine;
+    const regex_engine* engines[] = {&std_engine, &default_engine};
+    for (auto engine : engines)
+    {
+        std::vector<std::shared_ptr<const regex_pattern>> compiled;
+        for (auto p : patterns)
+        {
+            compiled.push_back(engine->compile(p, false));
+        }
+        std::size_t matches = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < 20; ++rep)
+        {
+            for (const auto& p : compiled)
+            {
+                for (const auto& v : values)
+                {
+                    matches += p->search(v) ? 1 : 0;
+                }
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << (engine == &std_engine ? "std::regex: " : "default:    ")
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                  << matches << " matches\n";
+    }
+}
@@ -3,8 +3,10 @@
 
 #include <jsoncons/json.hpp>
 #include <jsoncons/source.hpp>
+#include <jsoncons/mmap_source.hpp>
 #include <catch/catch.hpp>
 #include <sstream>
+#include <fstream>
 #include <vector>
 #include <utility>
 #include <ctime>
@@ -531,3 +533,89 @@ TEST_CASE("binary_iterator_stream source tests")
         CHECK(source.position() == 9);
     }
 }
+
+TEST_CASE("mmap_source tests")
+{
+    using namespace jsoncons;
+
+    std::string path = "./input/address-book.json";
+    std::ifstream is(path);
+    json expected = json::parse(is);
+
+    SECTION("json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(path, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_cursor")
+    {
+        // a path would be taken as JSON text, so pass the source itself
+        basic_json_cursor<char,mmap_source<char>> cursor{mmap_source<char>(path)};
+        json_decoder<json> decoder;
+        cursor.read_to(decoder);
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("parse string views into the mapping")
+    {
+        mmap_source<char> source(path);
+        REQUIRE_FALSE(source.is_error());
+        json j = json::parse(string_view_arg, string_view(source.data(), source.size()));
+        CHECK(j == expected);
+        CHECK(j["address-book"][0]["name"].storage_kind() == json_storage_kind::string_view_value);
+    }
+
+    SECTION("missing file")
+    {
+        mmap_source<char> source("./input/no-such-file.json");
+        CHECK(source.is_error());
+        CHECK(source.eof());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(std::string("./input/no-such-file.json"), decoder);
+        CHECK_THROWS_AS(reader.read(), ser_error);
+    }
+}
+
+TEST_CASE("binary_mmap_source tests")
+{
+    using namespace jsoncons;
+
+    std::string path = "./output/binary_mmap_source.bin";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << "0123456789";
+    }
+
+    SECTION("peek, read and ignore")
+    {
+        binary_mmap_source source(path);
+        REQUIRE_FALSE(source.is_error());
+        CHECK(source.size() == 10);
+
+        uint8_t b[4];
+        CHECK(source.peek().value == '0');
+        CHECK(source.read(b, 4) == 4);
+        CHECK(b[3] == '3');
+        source.ignore(2);
+        CHECK(source.position() == 6);
+        auto s = source.read_buffer();
+        CHECK(s.size() == 4);
+        CHECK(s[0] == '6');
+        CHECK(source.eof());
+        CHECK(source.peek().eof);
+    }
+
+    SECTION("move")
+    {
+        binary_mmap_source source(path);
+        source.ignore(3);
+        binary_mmap_source other(std::move(source));
+        CHECK(other.position() == 3);
+        CHECK(other.peek().value == '3');
+        CHECK(source.eof());
+    }
+}
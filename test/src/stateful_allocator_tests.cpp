@@ -67,3 +67,84 @@ TEST_CASE("test_string_allocation")
 }
 #endif
 
+
+TEST_CASE("test arena allocation")
+{
+    std::string input = R"(
+{
+    "name" : "A string long enough to need its own allocation",
+    "values" : [1, 2.5, "another string too long for short string", {"key with a long name to allocate": null}],
+    "nested" : {"a" : [[], {}], "b" : true}
+}
+    )";
+
+    SECTION("parse into arena")
+    {
+        json_arena arena;
+        {
+            json_decoder<arena_json> decoder(arena);
+            json_string_reader reader(input, decoder);
+            reader.read();
+            CHECK(decoder.is_valid());
+            arena_json j = decoder.get_result();
+
+            CHECK(j.get_allocator().arena() == &arena);
+            CHECK(j["values"].get_allocator().arena() == &arena);
+            CHECK(j["name"].as<std::string>() == "A string long enough to need its own allocation");
+            CHECK(j["values"][3].contains("key with a long name to allocate"));
+            CHECK(j.to_string() == json::parse(input).to_string());
+        }
+        CHECK(arena.allocation_count() > 0);
+        CHECK(arena.bytes_allocated() > 0);
+        CHECK(arena.bytes_reserved() >= arena.bytes_allocated());
+        CHECK(arena.chunk_count() >= 1);
+
+        arena.release();
+        CHECK(arena.allocation_count() == 0);
+        CHECK(arena.bytes_allocated() == 0);
+        CHECK(arena.bytes_reserved() == 0);
+        CHECK(arena.chunk_count() == 0);
+    }
+
+    SECTION("adopt")
+    {
+        json_arena arena(64);
+
+        json_decoder<arena_ojson> decoder(arena);
+        json_string_reader reader(input, decoder);
+        reader.read();
+        CHECK(decoder.is_valid());
+        arena_ojson& j = arena.adopt(decoder.get_result());
+
+        CHECK(j.to_string() == ojson::parse(input).to_string());
+        CHECK(arena.chunk_count() > 1);
+        j["nested"].insert_or_assign("c", arena_ojson("Added after parsing, with the arena's allocator", arena));
+        CHECK(j["nested"]["c"].get_allocator().arena() == &arena);
+
+        const arena_ojson& nested = j.at("nested");
+        arena_ojson& k = arena.adopt(nested);
+        CHECK(k == nested);
+        CHECK(&k != &nested);
+    }
+
+    SECTION("copy into arena")
+    {
+        json_arena arena;
+        arena_json j(json_object_arg, semantic_tag::none, arena);
+        j.try_emplace("first", arena_json("A string long enough to need its own allocation", arena));
+        j.try_emplace("second", arena_json(json_array_arg, {1,2,3}, semantic_tag::none, arena));
+
+        json_arena other;
+        arena_json copy(j, other);
+        CHECK(copy == j);
+        CHECK(copy.get_allocator().arena() == &other);
+        CHECK(other.allocation_count() > 0);
+    }
+
+    SECTION("default allocator")
+    {
+        arena_json j = arena_json::parse(input);
+        CHECK(j.get_allocator().arena() == nullptr);
+        CHECK(j.to_string() == json::parse(input).to_string());
+    }
+}
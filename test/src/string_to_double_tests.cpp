@@ -9,6 +9,8 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cstring>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -53,3 +55,63 @@ TEST_CASE("test_exponent")
 
 }
 
+TEST_CASE("chars_to round trip tests")
+{
+    jsoncons::detail::chars_to to_double;
+
+    SECTION("hard cases")
+    {
+        std::vector<std::string> inputs = {"9007199254740993",
+                                           "9007199254740992.5",
+                                           "2.2250738585072014e-308",
+                                           "2.2250738585072011e-308",
+                                           "1.7976931348623157e308",
+                                           "1e23",
+                                           "8.988465674311579e307",
+                                           "7.0e-10",
+                                           "-0.000000000000000000000000000001",
+                                           "123456789012345678901234567890",
+                                           "3.14159265358979323846264338327950288419716939937510",
+                                           "0.1000000000000000055511151231257827021181583404541015625",
+                                           "0.1000000000000000055511151231257827021181583404541015626"};
+        for (const auto& s : inputs)
+        {
+            char* end = nullptr;
+            double expected = strtod(s.c_str(), &end);
+            CHECK(to_double(s.c_str(), s.length()) == expected);
+        }
+    }
+
+    SECTION("zero")
+    {
+        double val = to_double("-0.0", 4);
+        CHECK(val == 0.0);
+        CHECK(std::signbit(val));
+    }
+
+    SECTION("random doubles")
+    {
+        std::mt19937_64 rng(20210701);
+        char buffer[64];
+        for (std::size_t i = 0; i < 100000; ++i)
+        {
+            uint64_t bits = rng();
+            double expected;
+            std::memcpy(&expected, &bits, sizeof(double));
+            if (!std::isfinite(expected))
+            {
+                continue;
+            }
+            int length = snprintf(buffer, sizeof(buffer), "%.17g", expected);
+            double val = to_double(buffer, static_cast<std::size_t>(length));
+            CHECK(std::memcmp(&val, &expected, sizeof(double)) == 0);
+        }
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-1.15507e-173";
+        CHECK(to_double(s.c_str(), s.length()) == -1.15507e-173);
+    }
+}
+